@@ -0,0 +1,356 @@
+#include "SDL3/SDL_timer.h"
+#include "ds/vector.hpp"
+#include "immpp/allocations.hpp"
+#include "immpp/initializer.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/malloc_interposer.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include "immpp/window.hpp"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace immpp;
+
+namespace {
+
+// === Config === //
+
+const vec2<i32> WINDOW_SIZE{1280, 720};
+const i32 WARMUP_FRAMES = 3;
+const std::array<i32, 5> COUNTS{10, 100, 1'000, 10'000, 100'000};
+
+struct Paths {
+  const c8* output = "immpp_bench.json";
+  const c8* font = "../assets/fonts/PixeloidSans.ttf";
+  const c8* image = "../assets/images/sample.png";
+  bool strict = false; // Fails when a measured frame allocates
+};
+
+struct Result {
+  const c8* scene;
+  i32 count;
+  i32 frames;
+  f64 ns_per_frame;
+  f64 allocations_per_frame;
+  i32 allocating_frames; // Measured frames with at least one allocation
+  f64 sdl_calls_per_frame;
+};
+
+// Less frames for the bigger scenes to keep the run time bounded
+[[nodiscard]] i32 get_frames(i32 count) noexcept {
+  return count >= 10'000 ? 10 : 60;
+}
+
+// === Scenes === //
+
+using Scene = void (*)(Window&, const Paths&, const ds::vector<i32>&, i32);
+
+void text_scene(
+    Window& window, const Paths& paths, const ds::vector<i32>& sizes, i32 count
+) noexcept {
+  std::array<c8, 16> label{};
+  window.start_column(sizes);
+  for (i32 i = 0; i < count; ++i) {
+    std::snprintf(label.data(), label.size(), "Label %d", i);
+    window.text(label.data());
+  }
+  window.end_column();
+}
+
+void image_button_scene(
+    Window& window, const Paths& paths, const ds::vector<i32>& sizes, i32 count
+) noexcept {
+  window.start_column(sizes);
+  for (i32 i = 0; i < count; ++i) {
+    if (window.image_button(paths.image)) {
+      logger::info("Button %d pressed", i);
+    }
+  }
+  window.end_column();
+}
+
+// Alternates rows and columns with 2 children until count leaves are used
+void nested_layout(Window& window, i32 count, bool row) noexcept {
+  if (count <= 1) {
+    window.fill_rectangle({0x80, 0x80, 0x80, 0xff});
+    return;
+  }
+
+  const std::array<i32, 2> halves{
+    size::encode_grow(count / 2), size::encode_grow(count - (count / 2))
+  };
+  if (row) {
+    window.start_row(halves.data(), halves.size());
+    nested_layout(window, count / 2, false);
+    nested_layout(window, count - (count / 2), false);
+    window.end_row();
+  } else {
+    window.start_column(halves.data(), halves.size());
+    nested_layout(window, count / 2, true);
+    nested_layout(window, count - (count / 2), true);
+    window.end_column();
+  }
+}
+
+void nested_scene(
+    Window& window, const Paths& paths, const ds::vector<i32>& sizes, i32 count
+) noexcept {
+  nested_layout(window, count, true);
+}
+
+void group_scene(
+    Window& window, const Paths& paths, const ds::vector<i32>& sizes, i32 count
+) noexcept {
+  window.start_column(sizes);
+  for (i32 i = 0; i < count; ++i) {
+    window.start_group();
+    {
+      window.add_group({0.0F, 0.0F, size::GROW_F32, size::GROW_F32});
+      window.fill_rectangle({0xff, 0x00, 0x00, 0xff});
+      window.add_group({2.0F, 2.0F, 8.0F, 8.0F});
+      window.rectangle({0x00, 0x00, 0xff, 0xff});
+    }
+    window.end_group();
+  }
+  window.end_column();
+}
+
+// count * 10 rows scrolled further every frame, so new rows keep missing the
+// table cache like a user dragging the scrollbar
+void table_scene(
+    Window& window, const Paths& paths, const ds::vector<i32>& sizes, i32 count
+) noexcept {
+  static i32 frame = 0; // NOLINT
+  const std::array<i32, 4> widths{
+    size::encode_fixed(96), size::encode_grow(2), size::encode_grow(1),
+    size::encode_fixed(128)
+  };
+  std::array<c8, 32> label{};
+
+  window.set_scroll("table", (f64)(++frame) * 160.0);
+  window.table(
+      "table", widths.data(), widths.size(), count * 10, 1,
+      [&label](i32 row, i32 column) {
+        if (row == 0) {
+          std::snprintf(label.data(), label.size(), "Column %d", column);
+        } else {
+          std::snprintf(
+              label.data(), label.size(), "%d:%d %08x", row, column,
+              (u32)row * 2'654'435'761U
+          );
+        }
+        return (const c8*)label.data();
+      }
+  );
+}
+
+struct SceneInfo {
+  const c8* name;
+  Scene scene;
+};
+
+const std::array<SceneInfo, 5> SCENES{
+  SceneInfo{"text", text_scene},
+  SceneInfo{"image_button", image_button_scene},
+  SceneInfo{"nested_layout", nested_scene},
+  SceneInfo{"group", group_scene},
+  SceneInfo{"table", table_scene},
+};
+
+// === Runner === //
+
+// Subsystems of the last frame, only counted with IMMPP_ALLOC_TRACKING
+void report_allocations(const c8* scene, i32 count, i32 frame) noexcept {
+  const auto& allocated = allocations::get_frame();
+  logger::warn(
+      "%s %d: frame %d after warmup allocated %llu times (%llu bytes)", scene,
+      count, frame, (unsigned long long)allocated.total.allocations,
+      (unsigned long long)allocated.total.bytes
+  );
+  for (i32 i = 0; i < allocations::SUBSYSTEM_COUNT; ++i) {
+    const allocations::Counter& counter = allocated.subsystems[i];
+    if (counter.allocations > 0) {
+      logger::warn(
+          "  %s: %llu allocations, %llu bytes",
+          allocations::get_name((allocations::Subsystem)i),
+          (unsigned long long)counter.allocations,
+          (unsigned long long)counter.bytes
+      );
+    }
+  }
+}
+
+[[nodiscard]] Result run(
+    Window& window, const Paths& paths, const SceneInfo& info, i32 count
+) noexcept {
+  ds::vector<i32> sizes{};
+  for (i32 i = 0; i < count; ++i) {
+    if (sizes.push(size::encode_fixed(16)) != error_codes::OK) {
+      logger::fatal("Bad Allocation on bench sizes");
+      std::abort();
+    }
+  }
+
+  for (i32 i = 0; i < WARMUP_FRAMES; ++i) {
+    static_cast<void>(window.start());
+    info.scene(window, paths, sizes, count);
+    window.end();
+  }
+
+  const i32 frames = get_frames(count);
+  u64 sdl_calls = 0;
+  i32 allocating_frames = 0;
+  const u64 start_allocations = malloc_interposer::get_calls();
+  const u64 start = SDL_GetTicksNS();
+  for (i32 i = 0; i < frames; ++i) {
+    const u64 frame_start = malloc_interposer::get_calls();
+    static_cast<void>(window.start());
+    info.scene(window, paths, sizes, count);
+    window.end();
+    sdl_calls += window.get_draw_stats().sdl_calls;
+
+    if (malloc_interposer::get_calls() != frame_start) {
+      if (allocating_frames == 0 && paths.strict) {
+        report_allocations(info.name, count, i);
+      }
+      ++allocating_frames;
+    }
+  }
+  const u64 elapsed = SDL_GetTicksNS() - start;
+  const u64 frame_allocations =
+      malloc_interposer::get_calls() - start_allocations;
+
+  return Result{
+    .scene = info.name,
+    .count = count,
+    .frames = frames,
+    .ns_per_frame = (f64)elapsed / frames,
+    .allocations_per_frame = malloc_interposer::is_enabled()
+                                 ? (f64)frame_allocations / frames
+                                 : -1.0,
+    .allocating_frames = allocating_frames,
+    .sdl_calls_per_frame = (f64)sdl_calls / frames,
+  };
+}
+
+[[nodiscard]] bool
+write_json(const c8* path, const ds::vector<Result>& results) noexcept {
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::fprintf(
+      file, "{\n  \"window\": [%d, %d],\n  \"results\": [\n", WINDOW_SIZE.x,
+      WINDOW_SIZE.y
+  );
+  for (i32 i = 0; i < results.get_size(); ++i) {
+    const Result& result = results[i];
+    std::fprintf(
+        file,
+        "    {\"scene\": \"%s\", \"count\": %d, \"frames\": %d, "
+        "\"ns_per_frame\": %.1f, \"allocations_per_frame\": %.2f, "
+        "\"allocating_frames\": %d, \"sdl_calls_per_frame\": %.2f}%s\n",
+        result.scene, result.count, result.frames, result.ns_per_frame,
+        result.allocations_per_frame, result.allocating_frames,
+        result.sdl_calls_per_frame,
+        i + 1 < results.get_size() ? "," : ""
+    );
+  }
+  std::fprintf(file, "  ]\n}\n");
+
+  return std::fclose(file) == 0;
+}
+
+} // namespace
+
+/**
+ * Usage: immpp_bench [--strict] [output.json] [font.ttf] [image.png]
+ *
+ * --strict fails when a frame after the warmup allocates, as a regression
+ * guard for steady state frames. Needs glibc to count allocations.
+ **/
+i32 main(i32 argc, c8** argv) noexcept {
+  Paths paths{};
+  if (argc > 1 && std::strcmp(argv[1], "--strict") == 0) {
+    paths.strict = true;
+    --argc;
+    ++argv;
+  }
+  if (argc > 1) {
+    paths.output = argv[1];
+  }
+  if (argc > 2) {
+    paths.font = argv[2];
+  }
+  if (argc > 3) {
+    paths.image = argv[3];
+  }
+
+  if (paths.strict && !malloc_interposer::is_enabled()) {
+    logger::error("--strict needs allocation counting, only on glibc");
+    return -1;
+  }
+
+  logger::set_level(LogLevel::WARN);
+
+  Initializer initializer{};
+  opt_error error = initializer.init_headless();
+  if (error) {
+    logger::error("Initializer error: %d\n", *error);
+    return -1;
+  }
+
+  ds::vector<Result> results{};
+  {
+    Window window{};
+    error = window.init_headless(WINDOW_SIZE);
+    if (error) {
+      logger::error("Window error: %d\n", *error);
+      return -1;
+    }
+
+    error = window.set_font(paths.font, 16);
+    if (error) {
+      logger::error("Font error: %d\n", *error);
+      return -1;
+    }
+
+    for (const auto& scene : SCENES) {
+      for (const i32 count : COUNTS) {
+        const Result result = run(window, paths, scene, count);
+        std::printf(
+            "%-14s %7d: %12.0f ns/frame %10.2f allocs/frame %3d/%-3d "
+            "allocating %8.2f sdl calls/frame\n",
+            result.scene, result.count, result.ns_per_frame,
+            result.allocations_per_frame, result.allocating_frames,
+            result.frames, result.sdl_calls_per_frame
+        );
+
+        if (results.push(result) != error_codes::OK) {
+          logger::fatal("Bad Allocation on bench results");
+          return -1;
+        }
+      }
+    }
+  }
+
+  if (!write_json(paths.output, results)) {
+    logger::error("Could not write '%s'", paths.output);
+    return -1;
+  }
+
+  if (paths.strict) {
+    for (const Result& result : results) {
+      if (result.allocating_frames > 0) {
+        logger::error("Steady state frames allocated, see the warnings");
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -40,7 +40,7 @@ void render_group(
     window.add_group(grow_rectangle);
     to_char(string, id);
     if (window.text_button(string.data())) {
-      logger::info("Pressed %d", id);
+      IMMPP_LOG_INFO("Pressed %d", id);
     }
   }
   window.end_group();
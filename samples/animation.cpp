@@ -3,7 +3,6 @@
 #include "immpp/size.hpp"
 #include "immpp/types.hpp"
 #include "immpp/window.hpp"
-#include <array>
 
 using namespace immpp;
 
@@ -33,29 +32,25 @@ i32 main() noexcept {
     window.set_fps(120);
     window.set_window_size({800, 800});
 
-    const std::array<i32, 2> heights{
-      size::encode_grow(1), size::encode_fixed(100)
-    };
-    const std::array<i32, 3> widths{
-      size::encode_fixed(32), size::encode_grow(1), size::encode_fixed(100)
-    };
     while (window.start()) {
-      window.start_column(heights.data(), heights.size());
+      window.start_column<size::encode_grow(1), size::encode_fixed(100)>();
       {
-        window.start_row(widths.data(), widths.size());
+        window.start_row<
+            size::encode_fixed(32), size::encode_grow(1),
+            size::encode_fixed(100)>();
         {
           window.start_group();
           {
             for (i32 i = 0; i < 5; ++i) {
               window.add_group({0.0F, 32.0F * i, 32.0F, 32.0F});
               if (window.image_button("../assets/images/sample.png")) {
-                logger::info("Tool %d pressed", i);
+                IMMPP_LOG_INFO("Tool %d pressed", i);
               }
             }
 
             window.add_group({0.0F, 32.0F * 5, size::GROW_F32, size::GROW_F32});
             if (window.image_button("../assets/images/sample.png")) {
-              logger::info("Tool %d pressed", 5);
+              IMMPP_LOG_INFO("Tool %d pressed", 5);
             }
           }
           window.end_group();
@@ -66,7 +61,7 @@ i32 main() noexcept {
             window.fill_rectangle({0xff, 0x00, 0x00, 0xff});
             window.add_group({0.0F, 0.0F, size::GROW_F32, size::GROW_F32});
             if (window.text_button("Canvas")) {
-              logger::info("Canvas pressed");
+              IMMPP_LOG_INFO("Canvas pressed");
             }
           }
           window.end_group();
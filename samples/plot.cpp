@@ -0,0 +1,73 @@
+#include "immpp/initializer.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/plot.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include "immpp/window.hpp"
+#include <array>
+#include <cmath>
+
+using namespace immpp;
+
+namespace {
+
+const i32 HISTORY = 1'000'000;
+const i32 SAMPLES_PER_FRAME = 2000;
+
+} // namespace
+
+i32 main() noexcept {
+  Initializer initializer{};
+  opt_error error = initializer.init();
+  if (error) {
+    logger::error("Initializer error: %d\n", *error);
+    return -1;
+  }
+
+  {
+    Window window{};
+    error = window.init("Plot");
+    if (error) {
+      logger::error("Window error: %d\n", *error);
+      return -1;
+    }
+
+    // Configuration
+    error = window.set_font("../assets/fonts/PixeloidSans.ttf", 16);
+    if (error) {
+      logger::error("Font error: %d\n", *error);
+      return -1;
+    }
+
+    PlotSeries series{};
+    if (series.set_capacity(HISTORY) != error_codes::OK) {
+      logger::error("Plot error: could not allocate the history\n");
+      return -1;
+    }
+
+    std::array<f32, SAMPLES_PER_FRAME> samples{};
+    u32 noise = 1;
+    i32 time = 0;
+    while (window.start()) {
+      // Live data, only the new samples update the block ranges
+      for (f32& sample : samples) {
+        noise = (noise * 1'103'515'245U) + 12'345U;
+        sample = std::sin((f32)time * 0.0005F) +
+                 ((f32)((noise >> 16) & 0xff) / 1024.0F);
+        ++time;
+      }
+      series.push(samples.data(), samples.size());
+
+      window.start_column<size::encode_fixed(24), size::encode_grow(1)>();
+      {
+        window.text(window.format("%d samples", series.get_size()));
+        window.plot(series, {0x20, 0x60, 0xc0, 0xff});
+      }
+      window.end_column();
+
+      window.end();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include "immpp/initializer.hpp"
+#include "immpp/layout.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include "immpp/window.hpp"
+
+using namespace immpp;
+
+namespace {
+
+const i32 ITEM_COUNT = 1'000'000;
+const f32 ITEM_HEIGHT = 16.0F;
+
+} // namespace
+
+i32 main() noexcept {
+  Initializer initializer{};
+  opt_error error = initializer.init();
+  if (error) {
+    logger::error("Initializer error: %d\n", *error);
+    return -1;
+  }
+
+  {
+    Window window{};
+    error = window.init("Scroll");
+    if (error) {
+      logger::error("Window error: %d\n", *error);
+      return -1;
+    }
+
+    // Configuration
+    error = window.set_font("../assets/fonts/PixeloidSans.ttf", 16);
+    if (error) {
+      logger::error("Font error: %d\n", *error);
+      return -1;
+    }
+    window.set_idle_mode(true);
+
+    while (window.start()) {
+      window.start_column<size::encode_fixed(24), size::encode_grow(1)>();
+      {
+        const CullStats& stats = window.get_cull_stats();
+        window.text(window.format(
+            "%d items, %d drawn, %d culled", ITEM_COUNT, stats.drawn,
+            stats.culled
+        ));
+
+        // Only the visible rows get widget sizes
+        const ScrollRange range =
+            window.start_scroll("items", ITEM_COUNT, ITEM_HEIGHT);
+        for (i32 i = range.first; i < range.first + range.count; ++i) {
+          window.text(window.format("Item %d", i));
+        }
+        window.end_scroll();
+      }
+      window.end_column();
+
+      window.end();
+    }
+  }
+
+  return 0;
+}
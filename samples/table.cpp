@@ -0,0 +1,86 @@
+#include "immpp/initializer.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include "immpp/window.hpp"
+#include <array>
+#include <cstdio>
+
+using namespace immpp;
+
+namespace {
+
+const i32 ROW_COUNT = 1'000'000;
+const std::array<const c8*, 4> HEADERS{"Row", "Time", "Level", "Message"};
+const std::array<const c8*, 3> LEVELS{"INFO", "WARN", "ERROR"};
+
+} // namespace
+
+i32 main() noexcept {
+  Initializer initializer{};
+  opt_error error = initializer.init();
+  if (error) {
+    logger::error("Initializer error: %d\n", *error);
+    return -1;
+  }
+
+  {
+    Window window{};
+    error = window.init("Table");
+    if (error) {
+      logger::error("Window error: %d\n", *error);
+      return -1;
+    }
+
+    // Configuration
+    error = window.set_font("../assets/fonts/PixeloidSans.ttf", 16);
+    if (error) {
+      logger::error("Font error: %d\n", *error);
+      return -1;
+    }
+
+    const std::array<i32, 4> widths{
+      size::encode_fixed(96), size::encode_fixed(128), size::encode_fixed(80),
+      size::encode_grow(1)
+    };
+    std::array<c8, 64> cell{};
+
+    while (window.start()) {
+      // Only called for cells scrolled into view
+      window.table(
+          "log", widths.data(), widths.size(), ROW_COUNT + 1, 1,
+          [&cell](i32 row, i32 column) {
+            if (row == 0) {
+              return HEADERS[column];
+            }
+
+            switch (column) {
+            case 0:
+              std::snprintf(cell.data(), cell.size(), "%d", row);
+              break;
+            case 1:
+              std::snprintf(
+                  cell.data(), cell.size(), "%02d:%02d:%02d.%03d",
+                  (row / 3'600'000) % 24, (row / 60'000) % 60,
+                  (row / 1000) % 60, row % 1000
+              );
+              break;
+            case 2:
+              return LEVELS[row % LEVELS.size()];
+            default:
+              std::snprintf(
+                  cell.data(), cell.size(), "Telemetry sample %08x",
+                  (u32)row * 2'654'435'761U
+              );
+              break;
+            }
+            return (const c8*)cell.data();
+          }
+      );
+
+      window.end();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,328 @@
+#include "immpp/draw_list.hpp"
+#include "SDL3/SDL_rect.h"
+#include "SDL3/SDL_render.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/frame_arena.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/profiler.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+
+namespace {
+
+// How many batches back a quad can be moved to
+const immpp::i32 MAX_LOOKBACK = 16;
+
+const SDL_FRect FULL_UV{.x = 0.0F, .y = 0.0F, .w = 1.0F, .h = 1.0F};
+
+[[nodiscard]] inline SDL_FColor to_fcolor(immpp::rgba8 color) noexcept {
+  return SDL_FColor{
+    .r = color.r / 255.0F,
+    .g = color.g / 255.0F,
+    .b = color.b / 255.0F,
+    .a = color.a / 255.0F,
+  };
+}
+
+[[nodiscard]] inline bool
+overlaps(const SDL_FRect& lhs, const SDL_FRect& rhs) noexcept {
+  return lhs.x < rhs.x + rhs.w && rhs.x < lhs.x + lhs.w &&
+         lhs.y < rhs.y + rhs.h && rhs.y < lhs.y + lhs.h;
+}
+
+[[nodiscard]] inline SDL_FRect
+merge(const SDL_FRect& lhs, const SDL_FRect& rhs) noexcept {
+  const immpp::f32 x = std::min(lhs.x, rhs.x);
+  const immpp::f32 y = std::min(lhs.y, rhs.y);
+  return SDL_FRect{
+    .x = x,
+    .y = y,
+    .w = std::max(lhs.x + lhs.w, rhs.x + rhs.w) - x,
+    .h = std::max(lhs.y + lhs.h, rhs.y + rhs.h) - y,
+  };
+}
+
+// Room for count more values, doubling like push. False only when the
+// arena and the heap are exhausted
+template <typename T>
+[[nodiscard]] inline bool
+reserve_more(immpp::FrameVector<T>& vector, immpp::i32 count) noexcept {
+  const immpp::i32 needed = vector.get_size() + count;
+  const immpp::i32 capacity = needed <= vector.get_capacity()
+                                  ? needed
+                                  : std::max(needed, vector.get_capacity() * 2);
+  return vector.reserve(capacity) == immpp::error_codes::OK;
+}
+
+} // namespace
+
+namespace immpp {
+
+// === Commands === //
+
+void DrawList::fill_rectangle(
+    const SDL_FRect& rectangle, rgba8 color
+) noexcept {
+  this->push_quad(nullptr, rectangle, FULL_UV, to_fcolor(color));
+}
+
+void DrawList::rectangle(const SDL_FRect& rectangle, rgba8 color) noexcept {
+  // Same pixels as SDL_RenderRect, one quad per side
+  const SDL_FColor fcolor = to_fcolor(color);
+  const f32 inner_height = std::max(rectangle.h - 2.0F, 0.0F);
+
+  this->push_quad(
+      nullptr, {rectangle.x, rectangle.y, rectangle.w, 1.0F}, FULL_UV, fcolor
+  );
+  this->push_quad(
+      nullptr,
+      {rectangle.x, rectangle.y + rectangle.h - 1.0F, rectangle.w, 1.0F},
+      FULL_UV, fcolor
+  );
+  this->push_quad(
+      nullptr, {rectangle.x, rectangle.y + 1.0F, 1.0F, inner_height}, FULL_UV,
+      fcolor
+  );
+  this->push_quad(
+      nullptr,
+      {rectangle.x + rectangle.w - 1.0F, rectangle.y + 1.0F, 1.0F,
+       inner_height},
+      FULL_UV, fcolor
+  );
+}
+
+void DrawList::texture(
+    SDL_Texture* texture, const SDL_FRect& rectangle
+) noexcept {
+  this->push_quad(
+      texture, rectangle, FULL_UV, to_fcolor({0xff, 0xff, 0xff, 0xff})
+  );
+}
+
+void DrawList::textured_quad(
+    SDL_Texture* texture, const SDL_FRect& rectangle, const SDL_FRect& uv,
+    rgba8 color
+) noexcept {
+  this->push_quad(texture, rectangle, uv, to_fcolor(color));
+}
+
+void DrawList::text(
+    SDL_Renderer* renderer, TTF_Text* text, vec2<f32> position
+) noexcept {
+  this->flush(renderer);
+
+  const i32 clip_index = this->get_clip();
+  const Clip clip = clip_index < 0 ? Clip{.rect = {}, .enabled = false}
+                                   : this->clips[clip_index];
+  if (clip.enabled) {
+    SDL_SetRenderClipRect(renderer, &clip.rect);
+    ++this->frame.sdl_calls;
+  }
+
+  TTF_DrawRendererText(text, position.x, position.y);
+  ++this->frame.sdl_calls;
+
+  if (clip.enabled) {
+    SDL_SetRenderClipRect(renderer, nullptr);
+    ++this->frame.sdl_calls;
+  }
+}
+
+void DrawList::set_clip(const SDL_Rect* clip) noexcept {
+  Clip new_clip{.rect = {}, .enabled = clip != nullptr};
+  if (clip != nullptr) {
+    new_clip.rect = *clip;
+  }
+
+  if (this->clips.push(new_clip) != error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on draw list, keeping the previous clip");
+    return;
+  }
+  this->clip_start = this->batches.get_size();
+}
+
+void DrawList::set_arena(FrameArena* arena) noexcept {
+  this->vertices.set_arena(arena);
+  this->next_quads.set_arena(arena);
+  this->indices.set_arena(arena);
+  this->batches.set_arena(arena);
+  this->clips.set_arena(arena);
+  this->clip_start = 0;
+}
+
+// === Frame === //
+
+void DrawList::clear(SDL_Renderer* renderer, rgba8 color) noexcept {
+  this->frame = {};
+  // Arena buffers of the last frame are gone, clipping starts disabled
+  this->vertices.clear();
+  this->next_quads.clear();
+  this->indices.clear();
+  this->batches.clear();
+  this->clips.clear();
+  this->clip_start = 0;
+
+  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  SDL_RenderClear(renderer);
+  // Untextured batches use the draw blend mode, translucent fills need it
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  this->frame.sdl_calls += 3;
+}
+
+void DrawList::flush(SDL_Renderer* renderer) noexcept {
+  IMMPP_PROFILE_ZONE("flush");
+  i32 applied_clip = -1;
+  bool clipped = false;
+
+  // Enough for the largest batch, so the pushes below can not fail
+  this->indices.clear();
+  if (this->indices.reserve(this->next_quads.get_size() * 6) !=
+      error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on draw list, dropping the queued quads");
+    this->batches.clear();
+  }
+
+  for (const auto& batch : this->batches) {
+    if (batch.clip != applied_clip) {
+      const Clip& clip = this->clips[batch.clip];
+      if (clip.enabled || clipped) {
+        SDL_SetRenderClipRect(renderer, clip.enabled ? &clip.rect : nullptr);
+        ++this->frame.sdl_calls;
+      }
+      applied_clip = batch.clip;
+      clipped = clip.enabled;
+    }
+
+    this->indices.clear();
+    for (i32 quad = batch.first; quad != -1; quad = this->next_quads[quad]) {
+      const i32 base = quad * 4;
+      static_cast<void>(this->indices.push(base));
+      static_cast<void>(this->indices.push(base + 1));
+      static_cast<void>(this->indices.push(base + 2));
+      static_cast<void>(this->indices.push(base + 2));
+      static_cast<void>(this->indices.push(base + 3));
+      static_cast<void>(this->indices.push(base));
+    }
+
+    SDL_RenderGeometry(
+        renderer, batch.texture, this->vertices.get_data(),
+        this->vertices.get_size(), this->indices.get_data(),
+        this->indices.get_size()
+    );
+    ++this->frame.sdl_calls;
+  }
+
+  if (clipped) {
+    SDL_SetRenderClipRect(renderer, nullptr);
+    ++this->frame.sdl_calls;
+  }
+
+  this->frame.quads += this->next_quads.get_size();
+  this->frame.batches += this->batches.get_size();
+
+  // Keep the active clip for the commands after a mid frame flush
+  const Clip current =
+      this->clips.is_empty() ? Clip{.rect = {}, .enabled = false}
+                             : this->clips.back();
+  this->vertices.clear();
+  this->next_quads.clear();
+  this->batches.clear();
+  this->clips.clear();
+  // Fits the buffer that was just cleared
+  static_cast<void>(this->clips.push(current));
+  this->clip_start = 0;
+}
+
+void DrawList::present(SDL_Renderer* renderer) noexcept {
+  this->flush(renderer);
+
+  {
+    IMMPP_PROFILE_ZONE("present");
+    SDL_RenderPresent(renderer);
+    ++this->frame.sdl_calls;
+  }
+
+  this->last_frame = this->frame;
+}
+
+const DrawListStats& DrawList::get_stats() const noexcept {
+  return this->last_frame;
+}
+
+// === Private === //
+
+void DrawList::push_quad(
+    SDL_Texture* texture, const SDL_FRect& rectangle, const SDL_FRect& uv,
+    const SDL_FColor& color
+) noexcept {
+  // All or nothing, a quad without its batch would break the links
+  if (!reserve_more(this->vertices, 4) || !reserve_more(this->next_quads, 1) ||
+      !reserve_more(this->batches, 1) || this->get_clip() < 0) {
+    IMMPP_LOG_WARN("Bad Allocation on draw list, dropping a quad");
+    return;
+  }
+
+  const i32 quad = this->next_quads.get_size();
+  const f32 x1 = rectangle.x + rectangle.w;
+  const f32 y1 = rectangle.y + rectangle.h;
+  const f32 u1 = uv.x + uv.w;
+  const f32 v1 = uv.y + uv.h;
+
+  const SDL_Vertex quad_vertices[4]{
+    {{rectangle.x, rectangle.y}, color, {uv.x, uv.y}},
+    {{x1, rectangle.y}, color, {u1, uv.y}},
+    {{x1, y1}, color, {u1, v1}},
+    {{rectangle.x, y1}, color, {uv.x, v1}},
+  };
+  for (const auto& vertex : quad_vertices) {
+    static_cast<void>(this->vertices.push(vertex));
+  }
+  static_cast<void>(this->next_quads.push(-1));
+
+  const i32 index = this->find_batch(texture, rectangle);
+  if (index > -1) {
+    Batch& batch = this->batches[index];
+    this->next_quads[batch.last] = quad;
+    batch.last = quad;
+    batch.bounds = merge(batch.bounds, rectangle);
+    return;
+  }
+
+  static_cast<void>(this->batches.push(Batch{
+    .texture = texture,
+    .bounds = rectangle,
+    .clip = this->get_clip(),
+    .first = quad,
+    .last = quad,
+  }));
+}
+
+i32 DrawList::find_batch(
+    SDL_Texture* texture, const SDL_FRect& rectangle
+) const noexcept {
+  const i32 lowest =
+      std::max(this->clip_start, this->batches.get_size() - MAX_LOOKBACK);
+
+  // A quad can only be moved before the batches it does not overlap
+  for (i32 i = this->batches.get_size() - 1; i >= lowest; --i) {
+    const Batch& batch = this->batches[i];
+    if (batch.texture == texture) {
+      return i;
+    }
+    if (overlaps(batch.bounds, rectangle)) {
+      return -1;
+    }
+  }
+
+  return -1;
+}
+
+i32 DrawList::get_clip() noexcept {
+  if (this->clips.is_empty() &&
+      this->clips.push(Clip{.rect = {}, .enabled = false}) != error_codes::OK) {
+    return -1;
+  }
+  return this->clips.get_size() - 1;
+}
+
+} // namespace immpp
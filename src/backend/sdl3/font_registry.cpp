@@ -0,0 +1,154 @@
+#include "immpp/font_registry.hpp"
+#include "SDL3/SDL_iostream.h"
+#include "SDL3/SDL_stdinc.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/hash.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace immpp {
+
+FontRegistry& FontRegistry::operator=(FontRegistry&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  this->clear();
+  this->faces = std::move(rhs.faces);
+  this->fonts = std::move(rhs.fonts);
+
+  return *this;
+}
+
+FontRegistry::~FontRegistry() noexcept {
+  this->clear();
+}
+
+FontHandle FontRegistry::load(const c8* path, i32 size) noexcept {
+  const u64 hash = hash::string(path);
+  i32 face = this->find_face(hash, path);
+  if (face > -1) {
+    for (i32 i = 0; i < this->fonts.get_size(); ++i) {
+      if (this->fonts[i].face == face && this->fonts[i].size == size) {
+        return i;
+      }
+    }
+  } else {
+    face = this->load_face(hash, path);
+    if (face == -1) {
+      return INVALID_FONT;
+    }
+  }
+
+  // Closed by TTF_CloseFont, the face data outlives it
+  const auto& entry = this->faces[face];
+  SDL_IOStream* stream = SDL_IOFromConstMem(entry.data, entry.bytes);
+  if (stream == nullptr) {
+    IMMPP_LOG_WARN("Could not open font '%s'", path);
+    return INVALID_FONT;
+  }
+
+  TTF_Font* font = TTF_OpenFontIO(stream, true, (f32)size);
+  if (font == nullptr) {
+    IMMPP_LOG_WARN("Could not open font '%s' at size %d", path, size);
+    return INVALID_FONT;
+  }
+
+  if (this->fonts.push({.face = face, .size = size, .font = font}) !=
+      error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on font registry fonts");
+    TTF_CloseFont(font);
+    return INVALID_FONT;
+  }
+
+  ++this->faces[face].sizes;
+  return this->fonts.get_size() - 1;
+}
+
+TTF_Font* FontRegistry::get(FontHandle handle) const noexcept {
+  if (handle < 0 || handle >= this->fonts.get_size()) {
+    return nullptr;
+  }
+
+  return this->fonts[handle].font;
+}
+
+void FontRegistry::clear() noexcept {
+  for (i32 i = 0; i < this->fonts.get_size(); ++i) {
+    TTF_CloseFont(this->fonts[i].font);
+  }
+  this->fonts.clear();
+
+  for (i32 i = 0; i < this->faces.get_size(); ++i) {
+    SDL_free(this->faces[i].data);
+    std::free(this->faces[i].path);
+  }
+  this->faces.clear();
+}
+
+i32 FontRegistry::get_face_count() const noexcept {
+  return this->faces.get_size();
+}
+
+FontFaceStats FontRegistry::get_face_stats(i32 face) const noexcept {
+  if (face < 0 || face >= this->faces.get_size()) {
+    return {};
+  }
+
+  const auto& entry = this->faces[face];
+  return {.path = entry.path, .bytes = entry.bytes, .sizes = entry.sizes};
+}
+
+u64 FontRegistry::get_bytes() const noexcept {
+  u64 bytes = 0;
+  for (i32 i = 0; i < this->faces.get_size(); ++i) {
+    bytes += this->faces[i].bytes;
+  }
+
+  return bytes;
+}
+
+i32 FontRegistry::find_face(u64 hash, const c8* path) const noexcept {
+  for (i32 i = 0; i < this->faces.get_size(); ++i) {
+    const auto& face = this->faces[i];
+    if (face.hash == hash && std::strcmp(face.path, path) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+i32 FontRegistry::load_face(u64 hash, const c8* path) noexcept {
+  size_t bytes = 0;
+  void* data = SDL_LoadFile(path, &bytes);
+  if (data == nullptr) {
+    IMMPP_LOG_WARN("Could not read font '%s'", path);
+    return -1;
+  }
+
+  const u64 length = std::strlen(path) + 1;
+  auto* path_copy = (c8*)std::malloc(length);
+  if (path_copy == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on font registry path '%s'", path);
+    SDL_free(data);
+    return -1;
+  }
+  std::memcpy(path_copy, path, length);
+
+  const Face face{
+    .hash = hash, .path = path_copy, .data = data, .bytes = bytes, .sizes = 0
+  };
+  if (this->faces.push(face) != error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on font registry faces");
+    SDL_free(data);
+    std::free(path_copy);
+    return -1;
+  }
+
+  return this->faces.get_size() - 1;
+}
+
+} // namespace immpp
@@ -0,0 +1,97 @@
+#include "immpp/frame_pacer.hpp"
+#include "SDL3/SDL_timer.h"
+#include "immpp/profiler.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+
+namespace immpp {
+
+void FramePacer::set_fps(u32 fps) noexcept {
+  this->ns_per_frame = fps == 0 ? 0 : SDL_NS_PER_SECOND / fps;
+  this->deadline = 0;
+}
+
+void FramePacer::set_spin_threshold(u64 ns) noexcept {
+  this->spin_threshold = ns;
+}
+
+void FramePacer::begin_frame() noexcept {
+  this->frame_start = SDL_GetTicksNS();
+
+  // First frame or coming back from a long wait, restart the schedule
+  if (this->frame_start >= this->deadline) {
+    this->deadline = this->frame_start + this->ns_per_frame;
+  }
+}
+
+void FramePacer::end_frame() noexcept {
+  const u64 now = SDL_GetTicksNS();
+
+  this->history[this->history_index] = now - this->frame_start;
+  this->history_index = (this->history_index + 1) % HISTORY_SIZE;
+  this->history_size = std::min(this->history_size + 1, HISTORY_SIZE);
+
+  // Unlimited frame rate
+  if (this->ns_per_frame == 0) {
+    return;
+  }
+
+  if (now > this->deadline) {
+    // Do not try to catch up on the lost frames
+    ++this->missed_deadlines;
+    this->deadline = now + this->ns_per_frame;
+    return;
+  }
+
+  {
+    IMMPP_PROFILE_ZONE("sleep");
+    this->wait_until(this->deadline);
+  }
+  this->deadline += this->ns_per_frame;
+}
+
+FrameTimeStats FramePacer::get_stats() const noexcept {
+  FrameTimeStats stats{
+    .frames = this->history_size,
+    .missed_deadlines = this->missed_deadlines,
+  };
+  if (this->history_size == 0) {
+    return stats;
+  }
+
+  std::array<u64, HISTORY_SIZE> sorted{};
+  u64 total = 0;
+  for (i32 i = 0; i < this->history_size; ++i) {
+    sorted[i] = this->history[i];
+    total += this->history[i];
+  }
+  std::sort(sorted.begin(), sorted.begin() + this->history_size);
+
+  stats.min = sorted[0];
+  stats.max = sorted[this->history_size - 1];
+  stats.avg = total / this->history_size;
+  stats.p50 = sorted[(this->history_size - 1) / 2];
+  stats.p99 = sorted[((this->history_size - 1) * 99) / 100];
+
+  return stats;
+}
+
+u64 FramePacer::get_frame_start() const noexcept {
+  return this->frame_start;
+}
+
+void FramePacer::wait_until(u64 time) const noexcept {
+  u64 now = SDL_GetTicksNS();
+
+  // Sleep is coarse, leave the last stretch to the spin
+  if (time > now + this->spin_threshold) {
+    SDL_DelayNS(time - now - this->spin_threshold);
+  }
+
+  do {
+    now = SDL_GetTicksNS();
+  } while (now < time);
+}
+
+} // namespace immpp
@@ -0,0 +1,341 @@
+#include "immpp/glyph_atlas.hpp"
+#include "SDL3/SDL_pixels.h"
+#include "SDL3/SDL_properties.h"
+#include "SDL3/SDL_render.h"
+#include "SDL3/SDL_surface.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/hash.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/profiler.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const immpp::i32 INITIAL_CAPACITY = 256;
+const immpp::u32 REPLACEMENT_CHARACTER = 0xFFFD;
+
+// Decodes the next UTF-8 codepoint and advances index past it
+[[nodiscard]] immpp::u32 next_codepoint(
+    const immpp::c8* text, immpp::i32 text_length, immpp::i32& index
+) noexcept {
+  const auto* bytes = (const immpp::u8*)text;
+  immpp::u32 codepoint = bytes[index];
+  immpp::i32 extra = 0;
+
+  if (codepoint < 0x80) {
+    ++index;
+    return codepoint;
+  }
+
+  if ((codepoint & 0xE0) == 0xC0) {
+    codepoint &= 0x1F;
+    extra = 1;
+  } else if ((codepoint & 0xF0) == 0xE0) {
+    codepoint &= 0x0F;
+    extra = 2;
+  } else if ((codepoint & 0xF8) == 0xF0) {
+    codepoint &= 0x07;
+    extra = 3;
+  } else {
+    ++index;
+    return REPLACEMENT_CHARACTER;
+  }
+
+  ++index;
+  for (; extra > 0; --extra, ++index) {
+    if (index >= text_length || (bytes[index] & 0xC0) != 0x80) {
+      return REPLACEMENT_CHARACTER;
+    }
+    codepoint = (codepoint << 6) | (bytes[index] & 0x3F);
+  }
+
+  return codepoint;
+}
+
+[[nodiscard]] inline immpp::u64
+glyph_key(TTF_Font* font, immpp::f32 size, immpp::u32 codepoint) noexcept {
+  immpp::u64 key = immpp::hash::bytes(&font, sizeof(font));
+  key = immpp::hash::bytes(&size, sizeof(size), key);
+  key = immpp::hash::bytes(&codepoint, sizeof(codepoint), key);
+  return key == 0 ? 1 : key; // 0 marks an empty slot
+}
+
+} // namespace
+
+namespace immpp {
+
+GlyphAtlas::GlyphAtlas(GlyphAtlas&& other) noexcept
+    : texture(other.texture), texture_size(other.texture_size),
+      max_texture_size(other.max_texture_size), cursor(other.cursor),
+      shelf_height(other.shelf_height), glyphs(other.glyphs),
+      capacity(other.capacity), stats(other.stats) {
+  other.texture = nullptr;
+  other.glyphs = nullptr;
+  other.capacity = 0;
+}
+
+GlyphAtlas& GlyphAtlas::operator=(GlyphAtlas&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  this->clear();
+  std::free(this->glyphs);
+
+  this->texture = rhs.texture;
+  this->texture_size = rhs.texture_size;
+  this->max_texture_size = rhs.max_texture_size;
+  this->cursor = rhs.cursor;
+  this->shelf_height = rhs.shelf_height;
+  this->glyphs = rhs.glyphs;
+  this->capacity = rhs.capacity;
+  this->stats = rhs.stats;
+
+  rhs.texture = nullptr;
+  rhs.glyphs = nullptr;
+  rhs.capacity = 0;
+
+  return *this;
+}
+
+GlyphAtlas::~GlyphAtlas() noexcept {
+  this->clear();
+  std::free(this->glyphs);
+  this->glyphs = nullptr;
+}
+
+void GlyphAtlas::draw(
+    SDL_Renderer* renderer, DrawList& draws, TTF_Font* font, const c8* text,
+    i32 text_length, vec2<f32> position, rgba8 color
+) noexcept {
+  if (font == nullptr || text_length <= 0) {
+    return;
+  }
+
+  if (this->texture == nullptr && !this->create_texture(renderer)) {
+    return;
+  }
+
+  f32 pen = position.x;
+  u32 previous = 0;
+  i32 index = 0;
+  while (index < text_length) {
+    const u32 codepoint = next_codepoint(text, text_length, index);
+    const Glyph* glyph = this->get_glyph(renderer, draws, font, codepoint);
+    if (glyph == nullptr) {
+      continue;
+    }
+
+    // Same pair adjustments as TTF_RenderText and TTF_GetStringSize
+    i32 kerning = 0;
+    if (previous != 0 &&
+        TTF_GetGlyphKerning(font, previous, codepoint, &kerning)) {
+      pen += (f32)kerning;
+    }
+    previous = codepoint;
+
+    // The texture can grow while the glyphs of the string are added
+    const f32 inverse_size = 1.0F / (f32)this->texture_size;
+    const SDL_FRect& source = glyph->source;
+    draws.textured_quad(
+        this->texture, {pen, position.y, source.w, source.h},
+        {source.x * inverse_size, source.y * inverse_size,
+         source.w * inverse_size, source.h * inverse_size},
+        color
+    );
+
+    pen += glyph->advance;
+  }
+}
+
+void GlyphAtlas::clear() noexcept {
+  if (this->texture != nullptr) {
+    SDL_DestroyTexture(this->texture);
+    this->texture = nullptr;
+  }
+
+  if (this->glyphs != nullptr) {
+    std::memset(this->glyphs, 0, sizeof(Glyph) * this->capacity);
+  }
+  this->cursor = {};
+  this->shelf_height = 0;
+  this->stats.count = 0;
+}
+
+const GlyphAtlasStats& GlyphAtlas::get_stats() const noexcept {
+  return this->stats;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::get_glyph(
+    SDL_Renderer* renderer, DrawList& draws, TTF_Font* font, u32 codepoint
+) noexcept {
+  const u64 key = glyph_key(font, TTF_GetFontSize(font), codepoint);
+
+  if (this->stats.count * 2 >= this->capacity && !this->grow_table()) {
+    return nullptr;
+  }
+
+  Glyph* slot = this->find_slot(key);
+  if (slot->key == key) {
+    ++this->stats.hits;
+    return slot;
+  }
+  ++this->stats.misses;
+  IMMPP_PROFILE_ZONE("glyph raster");
+
+  SDL_Surface* rendered = TTF_RenderGlyph_Blended(
+      font, codepoint, SDL_Color{0xff, 0xff, 0xff, 0xff}
+  );
+  if (rendered == nullptr) {
+    return nullptr;
+  }
+  SDL_Surface* surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_RGBA32);
+  SDL_DestroySurface(rendered);
+  if (surface == nullptr) {
+    return nullptr;
+  }
+
+  if (surface->w > this->texture_size || surface->h > this->texture_size) {
+    IMMPP_LOG_WARN("Glyph %u does not fit in the glyph atlas", codepoint);
+    SDL_DestroySurface(surface);
+    return nullptr;
+  }
+
+  // Shelf packing, go to the next shelf if the row is full
+  if (this->cursor.x + surface->w > this->texture_size) {
+    this->cursor.x = 0;
+    this->cursor.y += this->shelf_height;
+    this->shelf_height = 0;
+  }
+  if (this->cursor.y + surface->h > this->texture_size) {
+    // Atlas is full, submit the queued quads and repack into a larger
+    // texture, or from scratch at the largest size
+    draws.flush(renderer);
+    if (!this->grow_texture(renderer)) {
+      this->reset();
+      ++this->stats.resets;
+    }
+    slot = this->find_slot(key);
+  }
+
+  const SDL_Rect destination{
+    .x = this->cursor.x, .y = this->cursor.y, .w = surface->w, .h = surface->h
+  };
+  SDL_UpdateTexture(
+      this->texture, &destination, surface->pixels, surface->pitch
+  );
+
+  i32 advance = surface->w;
+  TTF_GetGlyphMetrics(
+      font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance
+  );
+
+  slot->key = key;
+  slot->source = SDL_FRect{
+    .x = (f32)destination.x,
+    .y = (f32)destination.y,
+    .w = (f32)destination.w,
+    .h = (f32)destination.h,
+  };
+  slot->advance = (f32)advance;
+  ++this->stats.count;
+
+  this->cursor.x += surface->w;
+  this->shelf_height = std::max(this->shelf_height, surface->h);
+  SDL_DestroySurface(surface);
+
+  return slot;
+}
+
+GlyphAtlas::Glyph* GlyphAtlas::find_slot(u64 key) noexcept {
+  const u64 mask = this->capacity - 1;
+  u64 index = key & mask;
+  while (this->glyphs[index].key != 0 && this->glyphs[index].key != key) {
+    index = (index + 1) & mask;
+  }
+  return this->glyphs + index;
+}
+
+bool GlyphAtlas::grow_table() noexcept {
+  const i32 old_capacity = this->capacity;
+  Glyph* old_glyphs = this->glyphs;
+
+  const i32 new_capacity =
+      old_capacity == 0 ? INITIAL_CAPACITY : old_capacity * 2;
+  auto* new_glyphs = (Glyph*)std::calloc(new_capacity, sizeof(Glyph));
+  if (new_glyphs == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on glyph table");
+    return false;
+  }
+
+  this->glyphs = new_glyphs;
+  this->capacity = new_capacity;
+  for (i32 i = 0; i < old_capacity; ++i) {
+    if (old_glyphs[i].key != 0) {
+      *this->find_slot(old_glyphs[i].key) = old_glyphs[i];
+    }
+  }
+  std::free(old_glyphs);
+
+  return true;
+}
+
+bool GlyphAtlas::create_texture(SDL_Renderer* renderer) noexcept {
+  if (this->max_texture_size == 0) {
+    const i64 limit = SDL_GetNumberProperty(
+        SDL_GetRendererProperties(renderer),
+        SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0
+    );
+    this->max_texture_size =
+        limit > 0 ? (i32)std::min<i64>(limit, MAX_TEXTURE_SIZE)
+                  : MAX_TEXTURE_SIZE;
+  }
+
+  this->stats.texture_size = this->texture_size;
+  this->texture = SDL_CreateTexture(
+      renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+      this->texture_size, this->texture_size
+  );
+  if (this->texture == nullptr) {
+    IMMPP_LOG_WARN("Could not create glyph atlas texture");
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(this->texture, SDL_BLENDMODE_BLEND);
+  // Keep pixel fonts crisp
+  SDL_SetTextureScaleMode(this->texture, SDL_SCALEMODE_NEAREST);
+  return true;
+}
+
+bool GlyphAtlas::grow_texture(SDL_Renderer* renderer) noexcept {
+  if (this->texture_size * 2 > this->max_texture_size) {
+    return false;
+  }
+
+  // The glyphs are rasterized again, the old texture can not be read back
+  SDL_Texture* old_texture = this->texture;
+  this->texture_size *= 2;
+  if (!this->create_texture(renderer)) {
+    this->texture_size /= 2;
+    this->stats.texture_size = this->texture_size;
+    this->texture = old_texture;
+    return false;
+  }
+
+  SDL_DestroyTexture(old_texture);
+  this->reset();
+  ++this->stats.grows;
+  return true;
+}
+
+void GlyphAtlas::reset() noexcept {
+  std::memset(this->glyphs, 0, sizeof(Glyph) * this->capacity);
+  this->cursor = {};
+  this->shelf_height = 0;
+  this->stats.count = 0;
+}
+
+} // namespace immpp
@@ -1,8 +1,60 @@
 #include "immpp/initializer.hpp"
+#include "SDL3/SDL_hints.h"
 #include "SDL3/SDL_init.h"
+#include "SDL3/SDL_stdinc.h"
 #include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/allocations.hpp"
 #include "immpp/types.hpp"
 
+namespace {
+
+#ifdef IMMPP_TRACK_ALLOCATIONS
+SDL_malloc_func original_malloc = nullptr;   // NOLINT
+SDL_calloc_func original_calloc = nullptr;   // NOLINT
+SDL_realloc_func original_realloc = nullptr; // NOLINT
+SDL_free_func original_free = nullptr;       // NOLINT
+
+// The original functions may end in a malloc interposer that records too
+void* SDLCALL tracked_malloc(size_t size) {
+  immpp::allocations::record(size);
+  const immpp::allocations::Untracked untracked{};
+  return original_malloc(size);
+}
+
+void* SDLCALL tracked_calloc(size_t count, size_t size) {
+  immpp::allocations::record(count * size);
+  const immpp::allocations::Untracked untracked{};
+  return original_calloc(count, size);
+}
+
+void* SDLCALL tracked_realloc(void* memory, size_t size) {
+  immpp::allocations::record(size);
+  const immpp::allocations::Untracked untracked{};
+  return original_realloc(memory, size);
+}
+#endif
+
+// Counts SDL, SDL_ttf and SDL_image allocations, has to run before the
+// first SDL call allocates
+void hook_allocations() noexcept {
+#ifdef IMMPP_TRACK_ALLOCATIONS
+  if (original_malloc != nullptr) {
+    return;
+  }
+
+  SDL_GetOriginalMemoryFunctions(
+      &original_malloc, &original_calloc, &original_realloc, &original_free
+  );
+  if (!SDL_SetMemoryFunctions(
+          tracked_malloc, tracked_calloc, tracked_realloc, original_free
+      )) {
+    original_malloc = nullptr;
+  }
+#endif
+}
+
+} // namespace
+
 namespace immpp {
 
 // NOLINTNEXTLINE
@@ -12,6 +64,7 @@ opt_error Initializer::init() noexcept {
   }
   this->initialized = false;
 
+  hook_allocations();
   if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
     return opt_error{error_codes::SDL_INIT};
   }
@@ -23,6 +76,20 @@ opt_error Initializer::init() noexcept {
   return ds::null;
 }
 
+// NOLINTNEXTLINE
+opt_error Initializer::init_headless() noexcept {
+  if (this->initialized) {
+    return ds::null;
+  }
+
+  hook_allocations();
+  if (!SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy")) {
+    return opt_error{error_codes::SDL_INIT};
+  }
+
+  return this->init();
+}
+
 Initializer::~Initializer() noexcept {
   if (!this->initialized) {
     return;
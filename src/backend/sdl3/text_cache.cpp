@@ -0,0 +1,67 @@
+#include "immpp/text_cache.hpp"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/hash.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <cstring>
+
+namespace immpp {
+
+void TextCache::set_capacity(i32 capacity) noexcept {
+  this->entries.set_capacity(capacity);
+  this->update_stats();
+}
+
+TextMeasure TextCache::measure(TTF_Font* font, const c8* text) noexcept {
+  TextMeasure output{};
+  if (font == nullptr) {
+    output.length = std::strlen(text);
+    return output;
+  }
+
+  const f32 font_size = TTF_GetFontSize(font);
+  u64 key = hash::bytes(&font, sizeof(font));
+  key = hash::bytes(&font_size, sizeof(font_size), key);
+  key = hash::string(text, output.length, key);
+
+  const Entry* cached = this->entries.find(key);
+  if (cached != nullptr && cached->measure.length == output.length) {
+    ++this->stats.hits;
+    return cached->measure;
+  }
+  ++this->stats.misses;
+
+  TTF_GetStringSize(font, text, output.length, &output.size.x, &output.size.y);
+
+  Entry* entry = this->entries.insert(key);
+  if (entry == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on text cache");
+  } else {
+    entry->measure = output;
+  }
+  this->update_stats();
+
+  return output;
+}
+
+void TextCache::next_frame() noexcept {
+  this->entries.next_frame();
+}
+
+void TextCache::clear() noexcept {
+  this->entries.clear();
+  this->update_stats();
+}
+
+const TextCacheStats& TextCache::get_stats() const noexcept {
+  return this->stats;
+}
+
+void TextCache::update_stats() noexcept {
+  this->stats.evictions = this->entries.get_evictions();
+  this->stats.grows = this->entries.get_grows();
+  this->stats.count = this->entries.get_count();
+  this->stats.capacity = this->entries.get_capacity();
+}
+
+} // namespace immpp
@@ -0,0 +1,148 @@
+#include "immpp/text_objects.hpp"
+#include "SDL3/SDL_render.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/hash.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <cstring>
+
+namespace immpp {
+
+TextObjects::TextObjects(TextObjects&& other) noexcept
+    : engine(other.engine), entries(std::move(other.entries)),
+      stats(other.stats) {
+  other.engine = nullptr;
+  other.stats.count = 0;
+}
+
+TextObjects& TextObjects::operator=(TextObjects&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  this->destroy();
+  this->engine = rhs.engine;
+  this->entries = std::move(rhs.entries);
+  this->stats = rhs.stats;
+  rhs.engine = nullptr;
+  rhs.stats.count = 0;
+
+  return *this;
+}
+
+TextObjects::~TextObjects() noexcept {
+  this->destroy();
+}
+
+TTF_Text* TextObjects::get(
+    SDL_Renderer* renderer, u64 id, TTF_Font* font, const c8* text,
+    i32 length, rgba8 color
+) noexcept {
+  if (font == nullptr) {
+    return nullptr;
+  }
+
+  if (this->engine == nullptr) {
+    this->engine = TTF_CreateRendererTextEngine(renderer);
+    if (this->engine == nullptr) {
+      IMMPP_LOG_WARN("Could not create the renderer text engine");
+      return nullptr;
+    }
+  }
+
+  u64 content = hash::bytes(&font, sizeof(font));
+  content = hash::bytes(text, length, content);
+  // Without an id the color is part of the key, so differently colored
+  // copies of a string do not keep updating one object
+  const u64 key = id != 0 ? id : hash::bytes(&color, sizeof(color), content);
+
+  Entry* entry = this->entries.find(key);
+  if (entry != nullptr) {
+    bool updated = false;
+    if (entry->content != content) {
+      if (entry->font != font) {
+        TTF_SetTextFont(entry->text, font);
+        entry->font = font;
+      }
+      TTF_SetTextString(entry->text, text, length);
+      entry->content = content;
+      updated = true;
+    }
+
+    if (std::memcmp(&entry->color, &color, sizeof(color)) != 0) {
+      TTF_SetTextColor(entry->text, color.r, color.g, color.b, color.a);
+      entry->color = color;
+      updated = true;
+    }
+
+    if (updated) {
+      ++this->stats.updates;
+    } else {
+      ++this->stats.hits;
+    }
+    return entry->text;
+  }
+
+  TTF_Text* object = TTF_CreateText(this->engine, font, text, length);
+  if (object == nullptr) {
+    IMMPP_LOG_WARN("Could not create text object");
+    return nullptr;
+  }
+  TTF_SetTextColor(object, color.r, color.g, color.b, color.a);
+
+  // Old objects are destroyed by the insert when the table is crowded
+  entry = this->entries.insert(key);
+  this->update_stats();
+  if (entry == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on text objects");
+    TTF_DestroyText(object);
+    return nullptr;
+  }
+
+  entry->content = content;
+  entry->font = font;
+  entry->text = object;
+  entry->color = color;
+  ++this->stats.creates;
+
+  return object;
+}
+
+void TextObjects::next_frame() noexcept {
+  this->entries.next_frame();
+}
+
+void TextObjects::clear() noexcept {
+  this->entries.clear();
+  this->update_stats();
+}
+
+void TextObjects::destroy() noexcept {
+  this->clear();
+
+  if (this->engine != nullptr) {
+    TTF_DestroyRendererTextEngine(this->engine);
+    this->engine = nullptr;
+  }
+}
+
+const TextObjectStats& TextObjects::get_stats() const noexcept {
+  return this->stats;
+}
+
+// === Private === //
+
+void TextObjects::destroy_entry(Entry& entry) noexcept {
+  if (entry.text != nullptr) {
+    TTF_DestroyText(entry.text);
+    entry.text = nullptr;
+  }
+}
+
+void TextObjects::update_stats() noexcept {
+  this->stats.evictions = this->entries.get_evictions();
+  this->stats.count = this->entries.get_count();
+  this->stats.capacity = this->entries.get_capacity();
+}
+
+} // namespace immpp
@@ -0,0 +1,141 @@
+#include "immpp/texture_cache.hpp"
+#include "SDL3/SDL_render.h"
+#include "SDL3/SDL_surface.h"
+#include "SDL3_image/SDL_image.h"
+#include "immpp/hash.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/profiler.hpp"
+#include "immpp/types.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace immpp {
+
+TextureCache& TextureCache::operator=(TextureCache&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  this->clear();
+  this->entries = std::move(rhs.entries);
+  this->stats = rhs.stats;
+  rhs.stats = {};
+
+  return *this;
+}
+
+TextureCache::~TextureCache() noexcept {
+  this->clear();
+}
+
+SDL_Texture*
+TextureCache::get(SDL_Renderer* renderer, const c8* path) noexcept {
+  const u64 hash = hash::string(path);
+  const i32 index = this->find(hash, path);
+  if (index > -1) {
+    ++this->stats.hits;
+    return this->entries[index].texture;
+  }
+  ++this->stats.misses;
+  IMMPP_PROFILE_ZONE("image load");
+
+  // Failures are cached too, so they are only loaded and reported once
+  SDL_Texture* texture = nullptr;
+  u64 bytes = 0;
+  SDL_Surface* surface = IMG_Load(path);
+  if (surface == nullptr) {
+    IMMPP_LOG_WARN("Could not create surface for image '%s'", path);
+  } else {
+    bytes = (u64)surface->pitch * surface->h;
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    if (texture == nullptr) {
+      IMMPP_LOG_WARN("Could not create texture for image '%s'", path);
+      bytes = 0;
+    }
+  }
+
+  const u64 length = std::strlen(path) + 1;
+  auto* path_copy = (c8*)std::malloc(length);
+  if (path_copy == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on texture cache path '%s'", path);
+    SDL_DestroyTexture(texture);
+    return nullptr;
+  }
+  std::memcpy(path_copy, path, length);
+
+  Entry entry{
+    .hash = hash, .path = path_copy, .texture = texture, .bytes = bytes
+  };
+  if (this->entries.push(entry) != error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on texture cache entries");
+    this->destroy_entry(entry);
+    return nullptr;
+  }
+
+  if (texture != nullptr) {
+    this->stats.bytes += bytes;
+    ++this->stats.count;
+  }
+  return texture;
+}
+
+void TextureCache::invalidate(const c8* path) noexcept {
+  const i32 index = this->find(hash::string(path), path);
+  if (index == -1) {
+    return;
+  }
+
+  auto& entry = this->entries[index];
+  if (entry.texture != nullptr) {
+    this->stats.bytes -= entry.bytes;
+    --this->stats.count;
+  }
+  this->destroy_entry(entry);
+
+  // Order does not matter, swap with the last entry
+  entry = this->entries.back();
+  static_cast<void>(this->entries.pop());
+}
+
+void TextureCache::clear() noexcept {
+  for (i32 i = 0; i < this->entries.get_size(); ++i) {
+    this->destroy_entry(this->entries[i]);
+  }
+  this->entries.clear();
+
+  this->stats.bytes = 0;
+  this->stats.count = 0;
+}
+
+const TextureCacheStats& TextureCache::get_stats() const noexcept {
+  return this->stats;
+}
+
+void TextureCache::reset_counters() noexcept {
+  this->stats.hits = 0;
+  this->stats.misses = 0;
+}
+
+i32 TextureCache::find(u64 hash, const c8* path) const noexcept {
+  for (i32 i = 0; i < this->entries.get_size(); ++i) {
+    const auto& entry = this->entries[i];
+    if (entry.hash == hash && std::strcmp(entry.path, path) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+void TextureCache::destroy_entry(Entry& entry) noexcept {
+  if (entry.texture != nullptr) {
+    SDL_DestroyTexture(entry.texture);
+    entry.texture = nullptr;
+  }
+
+  std::free(entry.path);
+  entry.path = nullptr;
+}
+
+} // namespace immpp
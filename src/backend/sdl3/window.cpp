@@ -1,6 +1,7 @@
 #include "immpp/window.hpp"
 #include "SDL3/SDL_events.h"
 #include "SDL3/SDL_mouse.h"
+#include "SDL3/SDL_pixels.h"
 #include "SDL3/SDL_rect.h"
 #include "SDL3/SDL_render.h"
 #include "SDL3/SDL_surface.h"
@@ -10,88 +11,73 @@
 #include "ds/optional.hpp"
 #include "ds/types.hpp"
 #include "ds/vector.hpp"
+#include "immpp/allocations.hpp"
+#include "immpp/frame_arena.hpp"
+#include "immpp/hash.hpp"
+#include "immpp/layout.hpp"
 #include "immpp/logger.hpp"
+#include "immpp/plot.hpp"
+#include "immpp/profiler.hpp"
 #include "immpp/size.hpp"
 #include "immpp/types.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <cstdlib>
+#include <cstdarg>
+#include <cstdio>
 #include <cstring>
 #include <unistd.h>
 
+namespace {
+
+const std::array<immpp::rgba8, 6> PROFILER_COLORS{
+  immpp::rgba8{0x4e, 0x79, 0xa7, 0xff}, immpp::rgba8{0xf2, 0x8e, 0x2b, 0xff},
+  immpp::rgba8{0x59, 0xa1, 0x4f, 0xff}, immpp::rgba8{0xe1, 0x57, 0x59, 0xff},
+  immpp::rgba8{0x76, 0xb7, 0xb2, 0xff}, immpp::rgba8{0xed, 0xc9, 0x48, 0xff},
+};
+const immpp::f32 PROFILER_ROW_HEIGHT = 16.0F;
+const immpp::f32 PROFILER_HISTORY_HEIGHT = 32.0F;
+
+// Frames rendered after the last event before idle mode blocks, lets
+// PRESSED/RELEASED mouse states settle
+const immpp::u8 IDLE_GRACE_FRAMES = 2;
+
+// Items scrolled per wheel notch
+const immpp::f32 SCROLL_LINES = 3.0F;
+const immpp::f32 SCROLLBAR_WIDTH = 4.0F;
+const immpp::f32 SCROLLBAR_MIN_THUMB = 8.0F;
+// Around the text of table cells
+const immpp::f32 TABLE_PADDING = 2.0F;
+
+} // namespace
+
 #define CHECK_LAYOUT(widget_id, widget_string)                                 \
   if (!this->state.widgets.is_empty() &&                                       \
       this->state.widgets.back() == widget_id) {                               \
-    logger::warn(                                                              \
+    IMMPP_LOG_WARN(                                                            \
         "Stacking the same layout (%s) is not allowed", widget_string          \
     );                                                                         \
     return;                                                                    \
   }                                                                            \
   if (this->state.widgets.push(widget_id) != error_codes::OK) {                \
-    logger::fatal("Bad Allocation on widgets");                                \
-    std::abort();                                                              \
+    IMMPP_LOG_WARN("Bad Allocation on widgets, skipping (%s)", widget_string); \
+    return;                                                                    \
   }
 
 namespace {
 
-[[nodiscard]] immpp::rect<immpp::f32>
-pop_widget_size(ds::vector<immpp::rect<immpp::f32>>& widget_sizes) noexcept {
+[[nodiscard]] immpp::rect<immpp::f32> pop_widget_size(
+    immpp::FrameVector<immpp::rect<immpp::f32>>& widget_sizes
+) noexcept {
+  // Also reached when a layout was skipped for running out of memory
   if (widget_sizes.is_empty()) {
-    immpp::logger::fatal("No available widget sizes");
-    std::abort();
+    IMMPP_LOG_WARN("No available widget sizes, skipping the widget");
+    return {};
   }
 
   return widget_sizes.pop();
 }
 
-// TODO: can add alignment logic here
-[[nodiscard]] SDL_FRect calculate_text_rectangle(
-    immpp::rect<immpp::f32> area, immpp::vec2<immpp::f32> fit_size,
-    immpp::vec2<immpp::f32> max_size
-) noexcept {
-  SDL_FRect output{
-    // std::trunc to avoid blurry text
-    .w = fit_size.x,
-    .h = fit_size.y
-  };
-
-  immpp::f32 tmp = 0.0F;
-  if (immpp::size::is_type(area.w)) {
-    tmp = immpp::size::is_fit(area.w) ? fit_size.x : max_size.x;
-  } else {
-    tmp = area.w;
-  }
-  // std::trunc to avoid blurry text
-  output.x = std::trunc(area.x + ((tmp - fit_size.x) / 2.0F));
-
-  if (immpp::size::is_type(area.h)) {
-    tmp = immpp::size::is_fit(area.h) ? fit_size.y : max_size.y;
-  } else {
-    tmp = area.h;
-  }
-  // std::trunc to avoid blurry text
-  output.y = std::trunc(area.y + ((tmp - fit_size.y) / 2.0F));
-
-  return output;
-}
-
-void normalize_rectangle(
-    immpp::rect<immpp::f32>& rectangle, const immpp::rect<immpp::f32>& limits
-) noexcept {
-  rectangle.x = std::trunc(rectangle.x);
-  rectangle.y = std::trunc(rectangle.y);
-  if (immpp::size::is_type(rectangle.w)) {
-    rectangle.w = limits.w - std::max(0.0F, rectangle.x - limits.x);
-  }
-  if (immpp::size::is_type(rectangle.h)) {
-    rectangle.h = limits.h - std::max(0.0F, rectangle.y - limits.y);
-  }
-}
-
-inline void set_color(SDL_Renderer* renderer, immpp::rgba8 color) noexcept {
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-}
-
 // NOTE: Can create a static vector implementation with ds
 [[nodiscard]] inline immpp::i32
 key_index(const ds::vector<immpp::u32>& keys, immpp::u32 key) noexcept {
@@ -104,23 +90,6 @@ key_index(const ds::vector<immpp::u32>& keys, immpp::u32 key) noexcept {
   return -1;
 }
 
-[[nodiscard]] inline SDL_Texture* create_text_texture(
-    SDL_Renderer* renderer, TTF_Font* font, const immpp::c8* text,
-    immpp::i32 text_length, immpp::rgba8 color
-) noexcept {
-  // Draw the text
-  SDL_Surface* surface =
-      TTF_RenderText_Solid(font, text, text_length, *(SDL_Color*)&color);
-  if (surface == nullptr) {
-    return nullptr;
-  }
-
-  SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-  SDL_DestroySurface(surface);
-
-  return texture;
-}
-
 inline void update_mouse_state(immpp::MouseState& mouse) {
   if (mouse == immpp::MouseState::PRESSED) {
     mouse = immpp::MouseState::DOWN;
@@ -134,9 +103,20 @@ inline void update_mouse_state(immpp::MouseState& mouse) {
 namespace immpp {
 
 Window::Window(Window&& other) noexcept
-    : window(other.window), renderer(other.renderer) {
+    : window(other.window), renderer(other.renderer), surface(other.surface),
+      font(other.font), fonts(std::move(other.fonts)), pacer(other.pacer),
+      arena(std::move(other.arena)), draws(std::move(other.draws)),
+      textures(std::move(other.textures)), glyphs(std::move(other.glyphs)),
+      texts(std::move(other.texts)),
+      text_objects(std::move(other.text_objects)),
+      layouts(std::move(other.layouts)), tables(std::move(other.tables)),
+      widget_states(std::move(other.widget_states)), theme(other.theme),
+      input(std::move(other.input)), state(std::move(other.state)) {
   other.window = nullptr;
   other.renderer = nullptr;
+  other.surface = nullptr;
+  other.font = nullptr;
+  this->attach_arena();
 }
 
 Window& Window::operator=(Window&& rhs) noexcept {
@@ -144,10 +124,30 @@ Window& Window::operator=(Window&& rhs) noexcept {
     return *this;
   }
 
+  this->destroy();
   this->window = rhs.window;
   this->renderer = rhs.renderer;
+  this->surface = rhs.surface;
+  this->font = rhs.font;
+  this->fonts = std::move(rhs.fonts);
+  this->pacer = rhs.pacer;
+  this->arena = std::move(rhs.arena);
+  this->draws = std::move(rhs.draws);
+  this->textures = std::move(rhs.textures);
+  this->glyphs = std::move(rhs.glyphs);
+  this->texts = std::move(rhs.texts);
+  this->text_objects = std::move(rhs.text_objects);
+  this->layouts = std::move(rhs.layouts);
+  this->tables = std::move(rhs.tables);
+  this->widget_states = std::move(rhs.widget_states);
+  this->theme = rhs.theme;
+  this->input = std::move(rhs.input);
+  this->state = std::move(rhs.state);
   rhs.window = nullptr;
   rhs.renderer = nullptr;
+  rhs.surface = nullptr;
+  rhs.font = nullptr;
+  this->attach_arena();
 
   return *this;
 }
@@ -166,25 +166,58 @@ opt_error Window::init(const c8* title) noexcept {
     return opt_error{error_codes::SDL_INIT};
   }
 
-  auto error = this->state.widget_sizes.reserve(4);
-  if (ds::is_error(error)) {
-    return opt_error{error_codes::SDL_BAD_ALLOCATION};
+  this->attach_arena();
+
+  return ds::null;
+}
+
+opt_error Window::init_headless(vec2<i32> size) noexcept {
+  this->state.window_size = size.to<f32>();
+  this->state.headless = true;
+
+  this->surface = SDL_CreateSurface(size.x, size.y, SDL_PIXELFORMAT_RGBA32);
+  if (this->surface == nullptr) {
+    return opt_error{error_codes::SDL_INIT};
+  }
+
+  this->renderer = SDL_CreateSoftwareRenderer(this->surface);
+  if (this->renderer == nullptr) {
+    return opt_error{error_codes::SDL_INIT};
   }
 
+  // Frames should run back to back
+  this->pacer.set_fps(0);
+
+  this->attach_arena();
+
   return ds::null;
 }
 
 Window::~Window() noexcept {
-  if (this->font != nullptr) {
-    TTF_CloseFont(this->font);
-    this->font = nullptr;
-  }
+  this->destroy();
+}
+
+void Window::destroy() noexcept {
+  // Text objects use the fonts and the renderer
+  this->text_objects.destroy();
+
+  this->font = nullptr;
+  this->fonts.clear();
+
+  // Textures should be destroyed before their renderer
+  this->textures.clear();
+  this->glyphs.clear();
 
   if (this->renderer != nullptr) {
     SDL_DestroyRenderer(this->renderer);
     this->renderer = nullptr;
   }
 
+  if (this->surface != nullptr) {
+    SDL_DestroySurface(this->surface);
+    this->surface = nullptr;
+  }
+
   if (this->window != nullptr) {
     SDL_DestroyWindow(this->window);
     this->window = nullptr;
@@ -192,26 +225,52 @@ Window::~Window() noexcept {
 }
 
 void Window::set_fps(u32 FPS) noexcept {
-  this->state.seconds_per_frame = 1000 / FPS;
+  this->pacer.set_fps(FPS);
+}
+
+void Window::set_idle_mode(bool enabled, i32 timeout_ms) noexcept {
+  this->state.idle_mode = enabled;
+  this->state.idle_timeout = timeout_ms;
+  this->state.idle_frames = 0;
 }
 
 opt_error Window::set_font(const c8* path, i32 size) noexcept {
-  this->font = TTF_OpenFont(path, 16);
-  if (this->font == nullptr) {
+  IMMPP_ALLOC_SCOPE(FONT);
+  const FontHandle handle = this->fonts.load(path, size);
+  if (handle == INVALID_FONT) {
     return opt_error{error_codes::SDL_INIT};
   }
 
+  this->state.default_font = handle;
+  if (this->state.font_stack.is_empty()) {
+    this->font = this->fonts.get(handle);
+  }
+
   return ds::null;
 }
 
 void Window::set_window_size(vec2<i32> size) noexcept {
+  if (this->state.headless) {
+    IMMPP_LOG_WARN("Headless windows have a fixed size");
+    return;
+  }
+
   this->state.window_size = size.to<f32>();
+  this->layouts.clear();
 
   if (this->window != nullptr) {
     SDL_SetWindowSize(this->window, size.x, size.y);
   }
 }
 
+void Window::set_retained_text(bool enabled) noexcept {
+  this->state.retained_text = enabled;
+}
+
+void Window::set_frame_arena_capacity(u64 bytes) noexcept {
+  this->arena.set_capacity(bytes);
+}
+
 // === Drawing Stuff === //
 
 // NOLINTNEXTLINE
@@ -220,180 +279,321 @@ bool Window::start() noexcept {
     return false;
   }
 
-  // Frame limiter time start
-  this->state.time = SDL_GetTicks();
-
   SDL_Event event{};
-  while (SDL_PollEvent(&event)) {
-    switch (event.type) {
-    case SDL_EVENT_QUIT:
-      return false;
-
-    case SDL_EVENT_MOUSE_MOTION:
-      this->input.mouse.position.x = event.motion.x;
-      this->input.mouse.position.y = event.motion.y;
-      break;
+  bool has_event = false;
+  if (this->state.idle_mode && !this->state.redraw_requested &&
+      this->state.idle_frames >= IDLE_GRACE_FRAMES) {
+    has_event = SDL_WaitEventTimeout(&event, this->state.idle_timeout);
+  } else {
+    has_event = SDL_PollEvent(&event);
+  }
 
-    case SDL_EVENT_MOUSE_BUTTON_DOWN:
-      if (event.button.button == SDL_BUTTON_LEFT) {
-        this->input.mouse.left = MouseState::PRESSED;
-        this->input.mouse.click.left_position.x = event.motion.x;
-        this->input.mouse.click.left_position.y = event.motion.y;
-      } else if (event.button.button == SDL_BUTTON_RIGHT) {
-        this->input.mouse.right = MouseState::PRESSED;
-        this->input.mouse.click.right_position.x = event.motion.x;
-        this->input.mouse.click.right_position.y = event.motion.y;
-      } else if (event.button.button == SDL_BUTTON_MIDDLE) {
-        this->input.mouse.middle = MouseState::PRESSED;
-        this->input.mouse.click.middle_position.x = event.motion.x;
-        this->input.mouse.click.middle_position.y = event.motion.y;
-      }
+  // Frame limiter time start, after a possible idle wait
+  this->pacer.begin_frame();
+  IMMPP_PROFILE_BEGIN_FRAME();
+  IMMPP_ALLOC_BEGIN_FRAME();
 
-      break;
+  if (has_event || this->state.redraw_requested) {
+    this->state.idle_frames = 0;
+  } else if (this->state.idle_frames < IDLE_GRACE_FRAMES) {
+    ++this->state.idle_frames;
+  }
+  this->state.redraw_requested = false;
+
+  {
+    IMMPP_PROFILE_ZONE("events");
+    IMMPP_ALLOC_SCOPE(INPUT);
+    this->input.mouse.scroll = {};
+    for (; has_event; has_event = SDL_PollEvent(&event)) {
+      switch (event.type) {
+      case SDL_EVENT_QUIT:
+        this->state.running = false;
+        break;
 
-    case SDL_EVENT_MOUSE_BUTTON_UP:
-      if (event.button.button == SDL_BUTTON_LEFT) {
-        this->input.mouse.left = MouseState::RELEASED;
-      } else if (event.button.button == SDL_BUTTON_RIGHT) {
-        this->input.mouse.right = MouseState::RELEASED;
-      } else if (event.button.button == SDL_BUTTON_MIDDLE) {
-        this->input.mouse.middle = MouseState::RELEASED;
-      }
-      break;
+      case SDL_EVENT_MOUSE_MOTION:
+        this->input.mouse.position.x = event.motion.x;
+        this->input.mouse.position.y = event.motion.y;
+        break;
+
+      case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        if (event.button.button == SDL_BUTTON_LEFT) {
+          this->input.mouse.left = MouseState::PRESSED;
+          this->input.mouse.click.left_position.x = event.motion.x;
+          this->input.mouse.click.left_position.y = event.motion.y;
+        } else if (event.button.button == SDL_BUTTON_RIGHT) {
+          this->input.mouse.right = MouseState::PRESSED;
+          this->input.mouse.click.right_position.x = event.motion.x;
+          this->input.mouse.click.right_position.y = event.motion.y;
+        } else if (event.button.button == SDL_BUTTON_MIDDLE) {
+          this->input.mouse.middle = MouseState::PRESSED;
+          this->input.mouse.click.middle_position.x = event.motion.x;
+          this->input.mouse.click.middle_position.y = event.motion.y;
+        }
 
-    case SDL_EVENT_KEY_DOWN:
-      if (this->input.keyboard.keys.get_size() >= 10) {
         break;
-      }
 
-      if (key_index(this->input.keyboard.keys, event.key.key) == -1) {
-        (void)this->input.keyboard.keys.push(event.key.key);
-      }
-      break;
+      case SDL_EVENT_MOUSE_BUTTON_UP:
+        if (event.button.button == SDL_BUTTON_LEFT) {
+          this->input.mouse.left = MouseState::RELEASED;
+        } else if (event.button.button == SDL_BUTTON_RIGHT) {
+          this->input.mouse.right = MouseState::RELEASED;
+        } else if (event.button.button == SDL_BUTTON_MIDDLE) {
+          this->input.mouse.middle = MouseState::RELEASED;
+        }
+        break;
 
-    case SDL_EVENT_KEY_UP:
-      if (this->input.keyboard.keys.is_empty()) {
+      case SDL_EVENT_MOUSE_WHEEL:
+        if (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED) {
+          this->input.mouse.scroll.x -= event.wheel.x;
+          this->input.mouse.scroll.y -= event.wheel.y;
+        } else {
+          this->input.mouse.scroll.x += event.wheel.x;
+          this->input.mouse.scroll.y += event.wheel.y;
+        }
         break;
-      }
 
-      {
-        i32 index = key_index(this->input.keyboard.keys, event.key.key);
-        if (index > -1) {
-          this->input.keyboard.keys.remove(index);
+      case SDL_EVENT_KEY_DOWN:
+        if (this->input.keyboard.keys.get_size() >= 10) {
+          break;
         }
-      }
-      break;
 
-    case SDL_EVENT_WINDOW_RESIZED:
-      this->state.window_size.x = event.window.data1;
-      this->state.window_size.y = event.window.data2;
-      break;
+        if (key_index(this->input.keyboard.keys, event.key.key) == -1) {
+          (void)this->input.keyboard.keys.push(event.key.key);
+        }
+        break;
 
-    default:
-      break;
+      case SDL_EVENT_KEY_UP:
+        if (this->input.keyboard.keys.is_empty()) {
+          break;
+        }
+
+        {
+          i32 index = key_index(this->input.keyboard.keys, event.key.key);
+          if (index > -1) {
+            this->input.keyboard.keys.remove(index);
+          }
+        }
+        break;
+
+      case SDL_EVENT_WINDOW_RESIZED:
+        this->state.window_size.x = event.window.data1;
+        this->state.window_size.y = event.window.data2;
+        this->layouts.clear();
+        break;
+
+      default:
+        break;
+      }
     }
   }
 
-  // Update variable values
+  // No frame follows, close the ones begun above
+  if (!this->state.running) {
+    IMMPP_PROFILE_END_FRAME();
+    IMMPP_ALLOC_END_FRAME();
+    return false;
+  }
+
+  // Update variable values, memory of the last frame is released here
+  this->arena.reset();
+  this->texts.next_frame();
+  this->layouts.next_frame();
+  this->tables.next_frame();
+  this->widget_states.next_frame();
+  this->text_objects.next_frame();
   this->state.widget_sizes.clear();
   this->state.widgets.clear();
+  this->state.ids.clear();
+  this->state.dropped_ids = 0;
+  this->state.text_count = 0;
+  this->state.scroll_regions.clear();
+  this->state.font_stack.clear();
+  this->state.dropped_fonts = 0;
+  this->font = this->fonts.get(this->state.default_font);
   static_cast<void>(this->state.widget_sizes.push(
       {.x = 0.0F, .y = 0.0F, .size = this->state.window_size}
   ));
+  this->state.clip = {.x = 0.0F, .y = 0.0F, .size = this->state.window_size};
+  this->state.culling = {};
 
   // Clear screen
-  SDL_SetRenderDrawColor(this->renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-  SDL_RenderClear(this->renderer);
+  IMMPP_ALLOC_SCOPE(DRAW);
+  this->draws.clear(this->renderer, {0xFF, 0xFF, 0xFF, 0xFF});
 
   return true;
 }
 
 void Window::end() noexcept {
-  SDL_RenderPresent(this->renderer);
+  {
+    IMMPP_ALLOC_SCOPE(DRAW);
+    this->draws.present(this->renderer);
+  }
 
   update_mouse_state(this->input.mouse.left);
   update_mouse_state(this->input.mouse.right);
   update_mouse_state(this->input.mouse.middle);
 
-  u64 delta = SDL_GetTicks() - this->state.time;
-  if (delta < this->state.seconds_per_frame) {
-    SDL_Delay(this->state.seconds_per_frame - delta);
-  }
+  this->state.last_culling = this->state.culling;
+
+  IMMPP_PROFILE_END_FRAME();
+  IMMPP_ALLOC_END_FRAME();
+  this->pacer.end_frame();
 }
 
 void Window::quit() noexcept {
   this->state.running = false;
 }
 
-// === Layouts === //
+void Window::request_redraw() noexcept {
+  this->state.redraw_requested = true;
+}
 
-void Window::set_anchor(u8 alignments) noexcept {
-  this->state.alignments = alignments;
+void Window::request_animation_frame() noexcept {
+  this->request_redraw();
+}
 
-  this->state.widget_sizes.clear();
-  static_cast<void>(this->state.widget_sizes.push(
-      {.x = 0.0F, .y = 0.0F, .size = this->state.window_size}
-  ));
+void Window::wake() noexcept {
+  SDL_Event event{};
+  event.type = SDL_EVENT_USER;
+  static_cast<void>(SDL_PushEvent(&event));
 }
 
-void Window::start_row(const i32* widths, i32 widths_size) noexcept {
-  CHECK_LAYOUT(Widget::ROW, "row");
+u64 Window::get_time() const noexcept {
+  return this->state.headless ? this->state.time
+                              : this->pacer.get_frame_start();
+}
+
+const c8* Window::format(const c8* format, ...) noexcept {
+  va_list args;
+  va_start(args, format);
+  const c8* output = this->arena.format(format, args);
+  va_end(args);
 
-  if (this->state.widget_sizes.is_empty()) {
-    logger::fatal("No available widget sizes");
-    std::abort();
+  if (output == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on formatted string");
+    return "";
   }
-  auto rectangle = pop_widget_size(this->state.widget_sizes);
+  return output;
+}
 
-  i32 width = 0;
-  i32 parts = 0;
-  f32 remaining_width = rectangle.w;
-  f32 full_width = rectangle.w;
-  for (i32 i = 0; i < widths_size; ++i) {
-    width = widths[i];
-    if (size::is_grow(width)) {
-      parts += size::decode_grow(width);
-    } else {
-      remaining_width -= size::decode_fixed(width);
-    }
+// === Headless === //
+
+void Window::set_time(u64 time_ns) noexcept {
+  this->state.time = time_ns;
+}
+
+void Window::advance_time(u64 delta_ns) noexcept {
+  this->state.time += delta_ns;
+}
+
+void Window::inject_event(const SDL_Event& event) noexcept {
+  SDL_Event copy = event;
+  if (!SDL_PushEvent(&copy)) {
+    IMMPP_LOG_WARN("Could not inject event %u", event.type);
   }
+}
 
-  remaining_width = std::max(remaining_width, 0.0F);
-  if (parts > 0) {
-    remaining_width /= parts;
-  } else {
-    switch (this->state.alignments & Alignment::HORIZONTAL_MASK) {
-    case Alignment::HORIZONTAL_LEFT:
-      full_width -= remaining_width;
-      break;
+void Window::inject_mouse_motion(vec2<f32> position) noexcept {
+  SDL_Event event{};
+  event.type = SDL_EVENT_MOUSE_MOTION;
+  event.motion.x = position.x;
+  event.motion.y = position.y;
+  this->inject_event(event);
+}
 
-    case Alignment::HORIZONTAL_CENTER:
-      full_width = (remaining_width / 2.0F) + (rectangle.w - remaining_width);
-      break;
+void Window::inject_mouse_button(
+    u8 button, bool down, vec2<f32> position
+) noexcept {
+  SDL_Event event{};
+  event.type = down ? SDL_EVENT_MOUSE_BUTTON_DOWN : SDL_EVENT_MOUSE_BUTTON_UP;
+  event.button.button = button;
+  event.button.down = down;
+  event.button.x = position.x;
+  event.button.y = position.y;
+  this->inject_event(event);
+}
 
-    default: // Alignment::HORIZONTAL_RIGHT:
-      break;
-    }
+void Window::inject_mouse_wheel(vec2<f32> delta) noexcept {
+  SDL_Event event{};
+  event.type = SDL_EVENT_MOUSE_WHEEL;
+  event.wheel.x = delta.x;
+  event.wheel.y = delta.y;
+  event.wheel.direction = SDL_MOUSEWHEEL_NORMAL;
+  event.wheel.mouse_x = this->input.mouse.position.x;
+  event.wheel.mouse_y = this->input.mouse.position.y;
+  this->inject_event(event);
+}
+
+void Window::inject_key(u32 key, bool down) noexcept {
+  SDL_Event event{};
+  event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+  event.key.key = key;
+  event.key.down = down;
+  this->inject_event(event);
+}
+
+const SDL_Surface* Window::get_framebuffer() const noexcept {
+  return this->surface;
+}
+
+// === Ids === //
+
+void Window::push_id(const c8* label) noexcept {
+  this->push_id_bytes(label, std::strlen(label));
+}
+
+void Window::push_id(const void* pointer) noexcept {
+  this->push_id_bytes(&pointer, sizeof(pointer));
+}
+
+void Window::push_id(i32 index) noexcept {
+  this->push_id_bytes(&index, sizeof(index));
+}
+
+void Window::pop_id() noexcept {
+  if (this->state.dropped_ids > 0) {
+    --this->state.dropped_ids;
+  } else if (!this->state.ids.is_empty()) {
+    static_cast<void>(this->state.ids.pop());
   }
+}
 
-  rect<f32> new_rect{.y = rectangle.y, .h = rectangle.h};
-  error_code error = error_codes::OK;
+WidgetId Window::get_id(const c8* label) const noexcept {
+  const WidgetId seed =
+      this->state.ids.is_empty() ? hash::FNV_OFFSET : this->state.ids.back();
+  return hash::string(label, seed);
+}
 
-  for (i32 i = widths_size - 1; i > -1; --i) {
-    width = widths[i];
-    if (size::is_grow(width)) {
-      new_rect.w = remaining_width * size::decode_grow(width);
-    } else {
-      new_rect.w = size::decode_fixed(width);
-    }
+WidgetState& Window::get_state(WidgetId id) noexcept {
+  return this->widget_states.get(id);
+}
 
-    full_width -= new_rect.w;
-    new_rect.x = rectangle.x + full_width;
-    error = this->state.widget_sizes.push(new_rect);
-    if (error != error_codes::OK) {
-      logger::fatal("Bad Allocation on widget_sizes");
-      std::abort();
-    }
+void Window::set_state_max_age(u32 frames) noexcept {
+  this->widget_states.set_max_age(frames);
+}
+
+// === Layouts === //
+
+void Window::set_anchor(u8 alignments) noexcept {
+  this->state.alignments = alignments;
+
+  this->state.widget_sizes.clear();
+  static_cast<void>(this->state.widget_sizes.push(
+      {.x = 0.0F, .y = 0.0F, .size = this->state.window_size}
+  ));
+}
+
+void Window::start_row(const i32* widths, i32 widths_size) noexcept {
+  CHECK_LAYOUT(Widget::ROW, "row");
+  IMMPP_PROFILE_ZONE("layout");
+  IMMPP_ALLOC_SCOPE(LAYOUT);
+  auto rectangle = pop_widget_size(this->state.widget_sizes);
+
+  if (this->layouts.push_row(
+          this->state.widget_sizes, rectangle, widths, widths_size,
+          this->state.alignments
+      ) != error_codes::OK) {
+    warn_layout();
   }
 }
 
@@ -410,60 +610,15 @@ void Window::end_row() noexcept {
 
 void Window::start_column(const i32* heights, i32 heights_size) noexcept {
   CHECK_LAYOUT(Widget::COLUMN, "column");
+  IMMPP_PROFILE_ZONE("layout");
+  IMMPP_ALLOC_SCOPE(LAYOUT);
   auto rectangle = pop_widget_size(this->state.widget_sizes);
 
-  i32 height = 0;
-  i32 parts = 0;
-  f32 remaining_height = rectangle.h;
-  f32 full_height = rectangle.h;
-
-  for (i32 i = 0; i < heights_size; ++i) {
-    height = heights[i];
-    if (size::is_grow(height)) {
-      parts += size::decode_grow(height);
-    } else {
-      remaining_height -= size::decode_fixed(height);
-    }
-  }
-
-  remaining_height = std::max(remaining_height, 0.0F);
-
-  if (parts > 0) {
-    remaining_height /= parts;
-  } else {
-    switch (this->state.alignments & Alignment::VERTICAL_MASK) {
-    case Alignment::VERTICAL_TOP:
-      full_height -= remaining_height;
-      break;
-
-    case Alignment::VERTICAL_CENTER:
-      full_height =
-          (remaining_height / 2.0F) + (rectangle.h - remaining_height);
-      break;
-
-    default: // Alignment::VERTICAL_BOTTOM:
-      break;
-    }
-  }
-
-  rect<f32> new_rect{.x = rectangle.x, .w = rectangle.w};
-  error_code error = error_codes::OK;
-
-  for (i32 i = heights_size - 1; i > -1; --i) {
-    height = heights[i];
-    if (size::is_grow(height)) {
-      new_rect.h = remaining_height * size::decode_grow(height);
-    } else {
-      new_rect.h = size::decode_fixed(height);
-    }
-
-    full_height -= new_rect.h;
-    new_rect.y = rectangle.y + full_height;
-    error = this->state.widget_sizes.push(new_rect);
-    if (error != error_codes::OK) {
-      logger::fatal("Bad Allocation on widget_sizes");
-      std::abort();
-    }
+  if (this->layouts.push_column(
+          this->state.widget_sizes, rectangle, heights, heights_size,
+          this->state.alignments
+      ) != error_codes::OK) {
+    warn_layout();
   }
 }
 
@@ -478,7 +633,34 @@ void Window::end_column() noexcept {
   }
 }
 
+bool Window::start_layout(Widget widget, rect<f32>& area) noexcept {
+  IMMPP_ALLOC_SCOPE(LAYOUT);
+  if (!this->state.widgets.is_empty() &&
+      this->state.widgets.back() == widget) {
+    IMMPP_LOG_WARN(
+        "Stacking the same layout (%s) is not allowed",
+        widget == Widget::ROW      ? "row"
+        : widget == Widget::COLUMN ? "column"
+                                   : "scroll"
+    );
+    return false;
+  }
+  if (this->state.widgets.push(widget) != error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on widgets, skipping the layout");
+    return false;
+  }
+
+  area = pop_widget_size(this->state.widget_sizes);
+  return true;
+}
+
+void Window::warn_layout() noexcept {
+  // The widgets still pop their sizes, the missing ones are skipped
+  IMMPP_LOG_WARN("Bad Allocation on widget_sizes, some widgets are skipped");
+}
+
 void Window::start_group(vec2<i32> size) noexcept {
+  IMMPP_ALLOC_SCOPE(LAYOUT);
   assert(
       !size::is_fit(size.x) && !size::is_fit(size.y) &&
       "Group width/height cannot be fixed"
@@ -502,16 +684,11 @@ void Window::start_group(vec2<i32> size) noexcept {
         (this->state.window_size.y - this->state.limits.h);
   }
 
-  auto sdl_rect = SDL_Rect{
-    .x = (i32)this->state.limits.x,
-    .y = (i32)this->state.limits.y,
-    .w = (i32)this->state.limits.w,
-    .h = (i32)this->state.limits.h
-  };
-  SDL_SetRenderClipRect(this->renderer, &sdl_rect);
+  this->set_clip(&this->state.limits);
 }
 
 void Window::add_group(const rect<f32>& rectangle) noexcept {
+  IMMPP_ALLOC_SCOPE(LAYOUT);
   if (this->state.widgets.back() != Widget::GROUP) {
     return;
   }
@@ -523,8 +700,7 @@ void Window::add_group(const rect<f32>& rectangle) noexcept {
   );
 
   if (error != error_codes::OK) {
-    logger::fatal("Bad Allocation on widget_sizes");
-    std::abort();
+    warn_layout();
   }
 }
 
@@ -535,132 +711,830 @@ void Window::end_group() noexcept {
   }
   this->state.widgets.pop();
 
-  SDL_SetRenderClipRect(this->renderer, nullptr);
+  this->set_clip(nullptr);
+}
+
+ScrollRange
+Window::start_scroll(const c8* id, i32 item_count, f32 item_height) noexcept {
+  IMMPP_PROFILE_ZONE("scroll");
+  IMMPP_ALLOC_SCOPE(LAYOUT);
+  rect<f32> area{};
+  if (!this->start_layout(Widget::SCROLL, area)) {
+    return {};
+  }
+  layout::normalize_rectangle(area, this->state.limits);
+
+  const f64 content = (f64)std::max(item_count, 0) * item_height;
+  const f64 offset =
+      this->scroll_area(this->get_id(id), area, content, item_height);
+
+  const ScrollRegion region{
+    .area = area,
+    .previous_clip = this->state.clip,
+    .content = content,
+    .offset = offset
+  };
+  if (this->state.scroll_regions.push(region) != error_codes::OK) {
+    // Without its region end_scroll can not restore the clip, skip it all
+    IMMPP_LOG_WARN("Bad Allocation on scroll_regions, skipping the scroll");
+    this->state.widgets.pop();
+    return {};
+  }
+  this->clip_to(area);
+
+  ScrollRange range =
+      layout::calculate_scroll_range(offset, area.h, item_height, item_count);
+  if (this->state.widget_sizes.reserve(
+          this->state.widget_sizes.get_size() + range.count
+      ) != error_codes::OK) {
+    warn_layout();
+    range.count = 0;
+  }
+
+  // Offset within the first item, the rest of the offset is in range.first
+  const f64 phase = offset - (f64)range.first * item_height;
+  const f32 width = content > area.h ? area.w - SCROLLBAR_WIDTH : area.w;
+  for (i32 i = range.count - 1; i >= 0; --i) {
+    const rect<f32> item{
+      .x = area.x,
+      .y = (f32)(area.y + (f64)i * item_height - phase),
+      .w = width,
+      .h = item_height
+    };
+    // Reserved above
+    static_cast<void>(this->state.widget_sizes.push(item));
+  }
+
+  return range;
+}
+
+void Window::end_scroll() noexcept {
+  if (this->state.widgets.is_empty() ||
+      this->state.widgets.back() != Widget::SCROLL ||
+      this->state.scroll_regions.is_empty()) {
+    return;
+  }
+  this->state.widgets.pop();
+  const ScrollRegion region = this->state.scroll_regions.pop();
+
+  this->draw_scrollbar(region.area, region.content, region.offset);
+  this->set_clip(&region.previous_clip);
+}
+
+void Window::set_scroll(const c8* id, f64 offset) noexcept {
+  this->widget_states.get(this->get_id(id)).scroll = offset;
+}
+
+// === Fonts === //
+
+FontHandle Window::load_font(const c8* path, i32 size) noexcept {
+  IMMPP_ALLOC_SCOPE(FONT);
+  return this->fonts.load(path, size);
+}
+
+void Window::push_font(FontHandle font) noexcept {
+  IMMPP_ALLOC_SCOPE(FONT);
+  // Under a dropped font the stack order has to stay, drop the nested ones
+  if (this->state.dropped_fonts > 0) {
+    ++this->state.dropped_fonts;
+    return;
+  }
+  if (this->state.font_stack.push(font) != error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on font_stack, keeping the current font");
+    ++this->state.dropped_fonts;
+    return;
+  }
+
+  TTF_Font* current = this->fonts.get(font);
+  if (current == nullptr) {
+    IMMPP_LOG_WARN("Pushing an invalid font, keeping the default one");
+    current = this->fonts.get(this->state.default_font);
+  }
+  this->font = current;
+}
+
+void Window::pop_font() noexcept {
+  if (this->state.dropped_fonts > 0) {
+    --this->state.dropped_fonts;
+    return;
+  }
+  if (this->state.font_stack.is_empty()) {
+    IMMPP_LOG_WARN("Popping a font without pushing one");
+    return;
+  }
+  static_cast<void>(this->state.font_stack.pop());
+
+  TTF_Font* current = nullptr;
+  if (!this->state.font_stack.is_empty()) {
+    current = this->fonts.get(this->state.font_stack.back());
+  }
+  if (current == nullptr) {
+    current = this->fonts.get(this->state.default_font);
+  }
+  this->font = current;
 }
 
 // === Widgets === //
 
 void Window::text(const c8* string) noexcept {
+  IMMPP_PROFILE_ZONE("text");
+  IMMPP_ALLOC_SCOPE(TEXT);
   const auto rectangle = pop_widget_size(this->state.widget_sizes);
-  i32 text_length = std::strlen(string);
 
-  // Compute the rect
-  vec2<i32> size{};
-  TTF_GetStringSize(this->font, string, text_length, &size.x, &size.y);
+  // Skips measuring, the slot is enough to know it is not visible
+  auto bounds = rectangle;
+  layout::normalize_rectangle(bounds, this->state.limits);
+  if (!this->is_visible(bounds)) {
+    return;
+  }
 
-  auto text_rect = calculate_text_rectangle(
-      rectangle, size.to<f32>(), this->state.limits.size
+  // Compute the rect
+  const auto measure = this->texts.measure(this->font, string);
+  auto text_rect = layout::calculate_text_rectangle(
+      rectangle, measure.size.to<f32>(), this->state.limits.size
   );
 
-  SDL_Texture* texture = create_text_texture(
-      this->renderer, this->font, string, text_length,
-      this->theme.foreground_color
+  this->draw_text(
+      this->next_text_id(), string, measure.length,
+      {.x = text_rect.x, .y = text_rect.y}, this->theme.foreground_color
   );
-  SDL_RenderTexture(this->renderer, texture, nullptr, &text_rect);
-  SDL_DestroyTexture(texture);
 }
 
 bool Window::text_button(const c8* text) noexcept {
-  auto rectangle = pop_widget_size(this->state.widget_sizes);
-  i32 text_length = std::strlen(text);
-
-  // Compute the rect
-  vec2<i32> size{};
-  TTF_GetStringSize(this->font, text, text_length, &size.x, &size.y);
-  const auto text_rect = calculate_text_rectangle(
-      rectangle, size.to<f32>(), this->state.limits.size
-  );
-  normalize_rectangle(rectangle, this->state.limits);
+  IMMPP_PROFILE_ZONE("text_button");
+  IMMPP_ALLOC_SCOPE(TEXT);
+  const auto area = pop_widget_size(this->state.widget_sizes);
+  auto rectangle = area;
+  layout::normalize_rectangle(rectangle, this->state.limits);
 
   bool last_clicked = rectangle.contains(this->input.mouse.click.left_position);
   bool mouseover = rectangle.contains(this->input.mouse.position);
+  const bool clicked = last_clicked && mouseover &&
+                       this->input.mouse.left == MouseState::RELEASED;
+  if (!this->is_visible(rectangle)) {
+    return clicked;
+  }
+
+  // Compute the rect
+  const auto measure = this->texts.measure(this->font, text);
+  const auto text_rect = layout::calculate_text_rectangle(
+      area, measure.size.to<f32>(), this->state.limits.size
+  );
   // Draw button background
   const auto foreground_color =
       mouseover ? this->theme.background_color : this->theme.foreground_color;
 
   if (mouseover) {
-    set_color(this->renderer, this->theme.foreground_color);
-    SDL_RenderFillRect(this->renderer, (SDL_FRect*)&rectangle);
+    this->draws.fill_rectangle(
+        *(SDL_FRect*)&rectangle, this->theme.foreground_color
+    );
   }
-  set_color(this->renderer, foreground_color);
-  SDL_RenderRect(this->renderer, (SDL_FRect*)&rectangle);
+  this->draws.rectangle(*(SDL_FRect*)&rectangle, foreground_color);
 
-  SDL_Texture* texture = create_text_texture(
-      this->renderer, this->font, text, text_length, foreground_color
+  this->draw_text(
+      this->next_text_id(), text, measure.length,
+      {.x = text_rect.x, .y = text_rect.y}, foreground_color
   );
-  SDL_RenderTexture(this->renderer, texture, nullptr, &text_rect);
-  SDL_DestroyTexture(texture);
 
-  return last_clicked && mouseover &&
-         this->input.mouse.left == MouseState::RELEASED;
+  return clicked;
 }
 
 void Window::image(const c8* path) noexcept {
+  IMMPP_PROFILE_ZONE("image");
+  IMMPP_ALLOC_SCOPE(IMAGE);
   auto rectangle = pop_widget_size(this->state.widget_sizes);
-  normalize_rectangle(rectangle, this->state.limits);
-
-  SDL_Surface* surface = IMG_Load(path);
-  if (surface == nullptr) {
-    logger::warn("Could not create surface for image '%s'", path);
+  layout::normalize_rectangle(rectangle, this->state.limits);
+  // Also keeps images that were never visible from being loaded
+  if (!this->is_visible(rectangle)) {
     return;
   }
 
-  SDL_Texture* texture = SDL_CreateTextureFromSurface(this->renderer, surface);
-  SDL_DestroySurface(surface);
+  SDL_Texture* texture = this->textures.get(this->renderer, path);
   if (texture == nullptr) {
-    logger::warn("Could not create texture for image '%s'", path);
+    return;
   }
 
-  SDL_RenderTexture(this->renderer, texture, nullptr, (SDL_FRect*)&rectangle);
-  SDL_DestroyTexture(texture);
+  this->draws.texture(texture, *(SDL_FRect*)&rectangle);
 }
 
 bool Window::image_button(const c8* path) noexcept {
+  IMMPP_PROFILE_ZONE("image_button");
+  IMMPP_ALLOC_SCOPE(IMAGE);
   auto rectangle = pop_widget_size(this->state.widget_sizes);
-  normalize_rectangle(rectangle, this->state.limits);
+  layout::normalize_rectangle(rectangle, this->state.limits);
 
   bool last_clicked = rectangle.contains(this->input.mouse.click.left_position);
   bool mouseover = rectangle.contains(this->input.mouse.position);
-
-  SDL_Surface* surface = IMG_Load(path);
-  if (surface == nullptr) {
-    logger::warn("Could not create surface for image '%s'", path);
-    return mouseover && this->input.mouse.left == MouseState::RELEASED;
+  const bool clicked = last_clicked && mouseover &&
+                       this->input.mouse.left == MouseState::RELEASED;
+  if (!this->is_visible(rectangle)) {
+    return clicked;
   }
 
-  SDL_Texture* texture = SDL_CreateTextureFromSurface(this->renderer, surface);
-  SDL_DestroySurface(surface);
+  SDL_Texture* texture = this->textures.get(this->renderer, path);
   if (texture == nullptr) {
-    logger::warn("Could not create texture for image '%s'", path);
-    return last_clicked && mouseover &&
-           this->input.mouse.left == MouseState::RELEASED;
+    return clicked;
   }
 
   if (mouseover) {
-    set_color(this->renderer, this->theme.foreground_color);
-    SDL_RenderFillRect(this->renderer, (SDL_FRect*)&rectangle);
+    this->draws.fill_rectangle(
+        *(SDL_FRect*)&rectangle, this->theme.foreground_color
+    );
   }
 
-  SDL_RenderTexture(this->renderer, texture, nullptr, (SDL_FRect*)&rectangle);
-  SDL_DestroyTexture(texture);
-  return last_clicked && mouseover &&
-         this->input.mouse.left == MouseState::RELEASED;
+  this->draws.texture(texture, *(SDL_FRect*)&rectangle);
+  return clicked;
 }
 
 void Window::rectangle(rgba8 color) noexcept {
+  IMMPP_PROFILE_ZONE("rectangle");
+  IMMPP_ALLOC_SCOPE(DRAW);
   auto rectangle = pop_widget_size(this->state.widget_sizes);
-  normalize_rectangle(rectangle, this->state.limits);
+  layout::normalize_rectangle(rectangle, this->state.limits);
+  if (!this->is_visible(rectangle)) {
+    return;
+  }
 
-  set_color(this->renderer, color);
-  SDL_RenderRect(this->renderer, (SDL_FRect*)&rectangle);
+  this->draws.rectangle(*(SDL_FRect*)&rectangle, color);
 }
 
 void Window::fill_rectangle(rgba8 color) noexcept {
+  IMMPP_PROFILE_ZONE("fill_rectangle");
+  IMMPP_ALLOC_SCOPE(DRAW);
+  auto rectangle = pop_widget_size(this->state.widget_sizes);
+  layout::normalize_rectangle(rectangle, this->state.limits);
+  if (!this->is_visible(rectangle)) {
+    return;
+  }
+
+  this->draws.fill_rectangle(*(SDL_FRect*)&rectangle, color);
+}
+
+void Window::invalidate_table(const c8* id) noexcept {
+  ++this->widget_states.get(this->get_id(id)).version;
+}
+
+void Window::plot(
+    const PlotSeries& series, rgba8 color, PlotRange range
+) noexcept {
+  IMMPP_PROFILE_ZONE("plot");
+  rect<f32> area{};
+  PlotRange* columns = this->start_plot(area, series.get_size());
+  if (columns == nullptr) {
+    return;
+  }
+
+  series.decimate(0, series.get_size(), columns, (i32)area.w);
+  this->draw_plot(area, columns, color, range);
+}
+
+void Window::plot(
+    const f32* values, i32 count, rgba8 color, PlotRange range
+) noexcept {
+  IMMPP_PROFILE_ZONE("plot");
+  rect<f32> area{};
+  PlotRange* columns = this->start_plot(area, count);
+  if (columns == nullptr) {
+    return;
+  }
+
+  plot::decimate(values, count, columns, (i32)area.w);
+  this->draw_plot(area, columns, color, range);
+}
+
+void Window::profiler_overlay() noexcept {
   auto rectangle = pop_widget_size(this->state.widget_sizes);
-  normalize_rectangle(rectangle, this->state.limits);
+  layout::normalize_rectangle(rectangle, this->state.limits);
+
+  const SDL_FRect area = *(SDL_FRect*)&rectangle;
+  const rgba8 text_color{0xff, 0xff, 0xff, 0xff};
+  this->draws.fill_rectangle(area, {0x00, 0x00, 0x00, 0xc0});
+
+  const profiler::FrameRecord* frame = profiler::get_frame(0);
+  if (frame == nullptr) {
+    this->glyphs.draw(
+        this->renderer, this->draws, this->font, "No profiler data", 16,
+        {.x = area.x + 2.0F, .y = area.y + 2.0F}, text_color
+    );
+    return;
+  }
+
+  // Counters
+  std::array<c8, 128> line{};
+  const auto frame_stats = this->pacer.get_stats();
+  const i32 length = std::snprintf(
+      line.data(), line.size(),
+      "frame %.2f ms  p99 %.2f ms  zones %d  dropped %d  sdl calls %d",
+      (frame->end - frame->start) / 1e6, frame_stats.p99 / 1e6,
+      frame->zone_count, frame->dropped_zones,
+      this->draws.get_stats().sdl_calls
+  );
+  this->glyphs.draw(
+      this->renderer, this->draws, this->font, line.data(),
+      std::min(length, (i32)line.size() - 1),
+      {.x = area.x + 2.0F, .y = area.y + 2.0F}, text_color
+  );
+
+  // Flame view of the zones, scaled to the frame duration
+  const f32 zones_y = area.y + PROFILER_ROW_HEIGHT + 4.0F;
+  const f32 duration = std::max<f32>(frame->end - frame->start, 1.0F);
+  const f32 scale = area.w / duration;
+  for (i32 i = 0; i < frame->zone_count; ++i) {
+    const auto& zone = frame->zones[i];
+    const u64 end = zone.end == 0 ? frame->end : zone.end;
+    const SDL_FRect bar{
+      .x = area.x + (zone.start - frame->start) * scale,
+      .y = zones_y + zone.depth * PROFILER_ROW_HEIGHT,
+      .w = std::max((end - zone.start) * scale, 1.0F),
+      .h = PROFILER_ROW_HEIGHT - 1.0F,
+    };
+    if (bar.y + bar.h > area.y + area.h - PROFILER_HISTORY_HEIGHT) {
+      continue;
+    }
+    this->draws.fill_rectangle(
+        bar, PROFILER_COLORS[hash::string(zone.name) % PROFILER_COLORS.size()]
+    );
+
+    const auto measure = this->texts.measure(this->font, zone.name);
+    if (measure.size.x + 4 < bar.w) {
+      this->glyphs.draw(
+          this->renderer, this->draws, this->font, zone.name, measure.length,
+          {.x = bar.x + 2.0F, .y = bar.y}, text_color
+      );
+    }
+  }
+
+  // Bar chart of the recent frame durations, newest on the right
+  f32 longest = 1.0F;
+  for (i32 age = 0; age < profiler::FRAME_HISTORY; ++age) {
+    const auto* record = profiler::get_frame(age);
+    if (record == nullptr) {
+      break;
+    }
+    longest = std::max<f32>(longest, record->end - record->start);
+  }
+
+  const f32 bar_width = area.w / profiler::FRAME_HISTORY;
+  const f32 bottom = area.y + area.h;
+  for (i32 age = 0; age < profiler::FRAME_HISTORY; ++age) {
+    const auto* record = profiler::get_frame(age);
+    if (record == nullptr) {
+      break;
+    }
+
+    const f32 height =
+        PROFILER_HISTORY_HEIGHT * (record->end - record->start) / longest;
+    this->draws.fill_rectangle(
+        {.x = area.x + area.w - (age + 1) * bar_width,
+         .y = bottom - height,
+         .w = std::max(bar_width - 1.0F, 1.0F),
+         .h = height},
+        PROFILER_COLORS[0]
+    );
+  }
+}
+
+// === Stats === //
+
+const DrawListStats& Window::get_draw_stats() const noexcept {
+  return this->draws.get_stats();
+}
+
+FrameTimeStats Window::get_frame_time_stats() const noexcept {
+  return this->pacer.get_stats();
+}
+
+const CullStats& Window::get_cull_stats() const noexcept {
+  return this->state.last_culling;
+}
+
+const FrameArenaStats& Window::get_frame_arena_stats() const noexcept {
+  return this->arena.get_stats();
+}
+
+// === Caches === //
+
+void Window::invalidate_image(const c8* path) noexcept {
+  // Queued quads might still reference the texture
+  this->draws.flush(this->renderer);
+  this->textures.invalidate(path);
+}
+
+void Window::clear_image_cache() noexcept {
+  this->draws.flush(this->renderer);
+  this->textures.clear();
+}
+
+const TextureCacheStats& Window::get_image_cache_stats() const noexcept {
+  return this->textures.get_stats();
+}
+
+const GlyphAtlasStats& Window::get_glyph_atlas_stats() const noexcept {
+  return this->glyphs.get_stats();
+}
+
+void Window::set_text_cache_capacity(i32 capacity) noexcept {
+  this->texts.set_capacity(capacity);
+}
+
+const TextCacheStats& Window::get_text_cache_stats() const noexcept {
+  return this->texts.get_stats();
+}
+
+const TextObjectStats& Window::get_text_object_stats() const noexcept {
+  return this->text_objects.get_stats();
+}
+
+void Window::set_table_cache_capacity(i32 capacity) noexcept {
+  this->tables.set_capacity(capacity);
+}
+
+const WidgetStoreStats& Window::get_widget_store_stats() const noexcept {
+  return this->widget_states.get_stats();
+}
+
+const TableCacheStats& Window::get_table_cache_stats() const noexcept {
+  return this->tables.get_stats();
+}
+
+const LayoutCacheStats& Window::get_layout_cache_stats() const noexcept {
+  return this->layouts.get_stats();
+}
+
+i32 Window::get_font_face_count() const noexcept {
+  return this->fonts.get_face_count();
+}
+
+FontFaceStats Window::get_font_face_stats(i32 face) const noexcept {
+  return this->fonts.get_face_stats(face);
+}
+
+// === Private === //
+
+void Window::draw_text(
+    WidgetId id, const c8* text, i32 length, vec2<f32> position, rgba8 color
+) noexcept {
+  if (this->state.retained_text) {
+    TTF_Text* object = this->text_objects.get(
+        this->renderer, id, this->font, text, length, color
+    );
+    if (object != nullptr) {
+      this->draws.text(this->renderer, object, position);
+      return;
+    }
+  }
+
+  this->glyphs.draw(
+      this->renderer, this->draws, this->font, text, length, position, color
+  );
+}
+
+WidgetId Window::next_text_id() noexcept {
+  const WidgetId seed =
+      this->state.ids.is_empty() ? hash::FNV_OFFSET : this->state.ids.back();
+  const u32 index = this->state.text_count++;
+  return hash::bytes(&index, sizeof index, seed);
+}
+
+bool Window::is_visible(const rect<f32>& rectangle) noexcept {
+  if (rectangle.overlaps(this->state.clip)) {
+    ++this->state.culling.drawn;
+    return true;
+  }
+
+  ++this->state.culling.culled;
+  return false;
+}
+
+void Window::set_clip(const rect<f32>* clip) noexcept {
+  if (clip == nullptr) {
+    this->draws.set_clip(nullptr);
+    this->state.clip = {.x = 0.0F, .y = 0.0F, .size = this->state.window_size};
+    return;
+  }
+
+  const auto sdl_rect = SDL_Rect{
+    .x = (i32)clip->x,
+    .y = (i32)clip->y,
+    .w = (i32)clip->w,
+    .h = (i32)clip->h
+  };
+  this->draws.set_clip(&sdl_rect);
+  this->state.clip = {
+    .x = (f32)sdl_rect.x,
+    .y = (f32)sdl_rect.y,
+    .w = (f32)sdl_rect.w,
+    .h = (f32)sdl_rect.h
+  };
+}
+
+void Window::clip_to(const rect<f32>& area) noexcept {
+  const rect<f32>& clip = this->state.clip;
+  const f32 left = std::max(area.x, clip.x);
+  const f32 top = std::max(area.y, clip.y);
+  const f32 right = std::min(area.x + area.w, clip.x + clip.w);
+  const f32 bottom = std::min(area.y + area.h, clip.y + clip.h);
+  const rect<f32> intersection{
+    .x = left,
+    .y = top,
+    .w = std::max(right - left, 0.0F),
+    .h = std::max(bottom - top, 0.0F)
+  };
+  this->set_clip(&intersection);
+}
+
+f64 Window::scroll_area(
+    WidgetId id, const rect<f32>& area, f64 content, f32 step
+) noexcept {
+  WidgetState& scroll = this->widget_states.get(id);
+  if (this->input.mouse.scroll.y != 0.0F &&
+      area.contains(this->input.mouse.position)) {
+    scroll.scroll -= this->input.mouse.scroll.y * step * SCROLL_LINES;
+    // Consumed, overlapping regions scroll only once
+    this->input.mouse.scroll = {};
+  }
+
+  scroll.scroll = layout::clamp_scroll(scroll.scroll, content, area.h);
+  return scroll.scroll;
+}
+
+void Window::draw_scrollbar(
+    const rect<f32>& area, f64 content, f64 offset
+) noexcept {
+  if (content <= area.h || !this->is_visible(area)) {
+    return;
+  }
+
+  IMMPP_ALLOC_SCOPE(DRAW);
+  const f32 thumb =
+      std::max((f32)(area.h * area.h / content), SCROLLBAR_MIN_THUMB);
+  const f64 progress = offset / (content - area.h);
+  const rect<f32> scrollbar{
+    .x = area.x + area.w - SCROLLBAR_WIDTH,
+    .y = (f32)(area.y + progress * (area.h - thumb)),
+    .w = SCROLLBAR_WIDTH,
+    .h = thumb
+  };
+  this->draws.fill_rectangle(
+      *(SDL_FRect*)&scrollbar, this->theme.foreground_color
+  );
+}
+
+ScrollRange Window::start_table(
+    const c8* id, const i32* widths, i32 widths_size, i32 row_count,
+    i32 header_rows
+) noexcept {
+  IMMPP_PROFILE_ZONE("table");
+  IMMPP_ALLOC_SCOPE(LAYOUT);
+  auto area = pop_widget_size(this->state.widget_sizes);
+  layout::normalize_rectangle(area, this->state.limits);
+
+  // Cells are cached per table version and font
+  const WidgetId table_id = this->get_id(id);
+  const u32 version = this->widget_states.get(table_id).version;
+  const f32 font_size =
+      this->font != nullptr ? TTF_GetFontSize(this->font) : 0.0F;
+  const f32 font_height =
+      this->font != nullptr ? (f32)TTF_GetFontHeight(this->font) : 0.0F;
+
+  TableFrame& table = this->state.table;
+  table.key = hash::bytes(&version, sizeof(version), table_id);
+  table.key = hash::bytes(&this->font, sizeof(this->font), table.key);
+  table.key = hash::bytes(&font_size, sizeof(font_size), table.key);
+  table.area = area;
+  table.previous_clip = this->state.clip;
+  table.row_height = font_height + (2.0F * TABLE_PADDING);
+  table.header_rows = std::clamp(header_rows, 0, std::max(row_count, 0));
+  table.header = std::min(table.header_rows * table.row_height, area.h);
+
+  // Only the body scrolls, under the header rows
+  const i32 body_rows = std::max(row_count, 0) - table.header_rows;
+  const rect<f32> body{
+    .x = area.x,
+    .y = area.y + table.header,
+    .w = area.w,
+    .h = area.h - table.header
+  };
+  table.content = (f64)body_rows * table.row_height;
+  table.offset =
+      this->scroll_area(table_id, body, table.content, table.row_height);
+
+  ScrollRange range = layout::calculate_scroll_range(
+      table.offset, body.h, table.row_height, body_rows
+  );
+  table.top =
+      (f32)(body.y - (table.offset - (f64)range.first * table.row_height));
+  range.first += table.header_rows;
+  table.first = range.first;
+
+  // One row laid out for all rows
+  const rect<f32> columns{
+    .x = area.x,
+    .y = area.y,
+    .w = table.content > body.h ? area.w - SCROLLBAR_WIDTH : area.w,
+    .h = table.row_height
+  };
+  this->state.table_columns.clear();
+  if (this->layouts.push_row(
+          this->state.table_columns, columns, widths, widths_size,
+          Alignment::HORIZONTAL_LEFT
+      ) != error_codes::OK) {
+    // Some columns would be missing, draw no cells instead
+    warn_layout();
+    this->state.table_columns.clear();
+  }
+
+  this->clip_to(body);
+  return range;
+}
+
+void Window::start_table_header() noexcept {
+  const TableFrame& table = this->state.table;
+  this->set_clip(&table.previous_clip);
+  if (table.header_rows == 0) {
+    return;
+  }
+
+  this->clip_to({.position = table.area.position,
+                 .size = {table.area.w, table.header}});
+  const rect<f32> separator{
+    .x = table.area.x,
+    .y = table.area.y + table.header - 1.0F,
+    .w = table.area.w,
+    .h = 1.0F
+  };
+  if (this->is_visible(separator)) {
+    IMMPP_ALLOC_SCOPE(DRAW);
+    this->draws.fill_rectangle(
+        *(SDL_FRect*)&separator, this->theme.foreground_color
+    );
+  }
+}
+
+void Window::end_table() noexcept {
+  const TableFrame& table = this->state.table;
+  this->set_clip(&table.previous_clip);
+  this->draw_scrollbar(
+      {.x = table.area.x,
+       .y = table.area.y + table.header,
+       .w = table.area.w,
+       .h = table.area.h - table.header},
+      table.content, table.offset
+  );
+}
+
+rect<f32> Window::get_table_cell_area(i32 row, i32 column) const noexcept {
+  const TableFrame& table = this->state.table;
+  const auto& columns = this->state.table_columns;
+  const rect<f32>& bounds = columns[columns.get_size() - 1 - column];
+
+  const f32 y = row < table.header_rows
+                    ? table.area.y + ((f32)row * table.row_height)
+                    : table.top + ((f32)(row - table.first) * table.row_height);
+  return {.x = bounds.x, .y = y, .w = bounds.w, .h = table.row_height};
+}
+
+u64 Window::get_table_cell_key(i32 row, i32 column) const noexcept {
+  const auto& columns = this->state.table_columns;
+  // The width is part of the key, cells are cut to it
+  const std::array<u32, 3> words{
+    (u32)row, (u32)column, (u32)columns[columns.get_size() - 1 - column].w
+  };
+  return hash::words(words.data(), words.size(), this->state.table.key);
+}
+
+const TableCell& Window::cache_table_cell(
+    u64 key, const rect<f32>& area, const c8* text
+) noexcept {
+  IMMPP_ALLOC_SCOPE(TEXT);
+  text = text != nullptr ? text : "";
+  if (this->font == nullptr) {
+    return this->tables.insert(key, text, 0);
+  }
+
+  // Only the part that fits the column is kept, cut between glyphs
+  const i32 max_width = std::max((i32)(area.w - (2.0F * TABLE_PADDING)), 0);
+  i32 width = 0;
+  size_t length = 0;
+  if (!TTF_MeasureString(this->font, text, 0, max_width, &width, &length)) {
+    return this->tables.insert(key, text, 0);
+  }
+
+  TableCell& cell = this->tables.insert(key, text, (i32)length);
+  cell.size = {width, TTF_GetFontHeight(this->font)};
+  if (cell.length != (i32)length) {
+    // Cut shorter than measured, e.g. out of memory for long text
+    static_cast<void>(TTF_GetStringSize(
+        this->font, this->tables.get_text(cell), cell.length, &cell.size.x,
+        &cell.size.y
+    ));
+  }
+  return cell;
+}
+
+void Window::draw_table_cell(
+    const TableCell& cell, const rect<f32>& area
+) noexcept {
+  if (cell.length == 0) {
+    return;
+  }
+
+  IMMPP_ALLOC_SCOPE(TEXT);
+  // The cell key is stable for the table, row and column
+  this->draw_text(
+      cell.key, this->tables.get_text(cell), cell.length,
+      {.x = area.x + TABLE_PADDING,
+       .y = area.y + std::trunc((area.h - (f32)cell.size.y) * 0.5F)},
+      this->theme.foreground_color
+  );
+}
+
+PlotRange* Window::start_plot(rect<f32>& area, i32 samples) noexcept {
+  IMMPP_ALLOC_SCOPE(DRAW);
+  area = pop_widget_size(this->state.widget_sizes);
+  layout::normalize_rectangle(area, this->state.limits);
+  // No samples leave the columns without a range to draw
+  if (samples <= 0 || area.w < 1.0F || area.h <= 0.0F ||
+      !this->is_visible(area)) {
+    return nullptr;
+  }
+
+  auto* columns = (PlotRange*)this->arena.allocate(
+      sizeof(PlotRange) * (u64)area.w, alignof(PlotRange)
+  );
+  if (columns == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on plot columns");
+  }
+  return columns;
+}
+
+void Window::draw_plot(
+    const rect<f32>& area, const PlotRange* columns, rgba8 color,
+    PlotRange range
+) noexcept {
+  IMMPP_ALLOC_SCOPE(DRAW);
+  const i32 count = (i32)area.w;
+  if (range.min >= range.max) {
+    range = columns[0];
+    for (i32 i = 1; i < count; ++i) {
+      range.min = std::min(range.min, columns[i].min);
+      range.max = std::max(range.max, columns[i].max);
+    }
+    // Flat lines sit in the middle
+    if (range.min >= range.max) {
+      range.min -= 1.0F;
+      range.max += 1.0F;
+    }
+  }
+
+  const f32 scale = area.h / (range.max - range.min);
+  const f32 bottom = area.y + area.h;
+  PlotRange previous = columns[0];
+  for (i32 i = 0; i < count; ++i) {
+    // Reaches into the previous column so steep parts stay connected
+    const PlotRange& column = columns[i];
+    const f32 low = std::min(column.min, previous.max);
+    const f32 high = std::max(column.max, previous.min);
+    previous = column;
+
+    const f32 top =
+        std::clamp(bottom - ((high - range.min) * scale), area.y, bottom);
+    const f32 base =
+        std::clamp(bottom - ((low - range.min) * scale), area.y, bottom);
+    this->draws.fill_rectangle(
+        {.x = area.x + (f32)i,
+         .y = top,
+         .w = 1.0F,
+         .h = std::max(base - top, 1.0F)},
+        color
+    );
+  }
+}
+
+void Window::push_id_bytes(const void* data, u64 length) noexcept {
+  IMMPP_ALLOC_SCOPE(LAYOUT);
+  // Under a dropped id the stack order has to stay, drop the nested ones too
+  if (this->state.dropped_ids > 0) {
+    ++this->state.dropped_ids;
+    return;
+  }
+
+  const WidgetId seed =
+      this->state.ids.is_empty() ? hash::FNV_OFFSET : this->state.ids.back();
+  if (this->state.ids.push(hash::bytes(data, length, seed)) !=
+      error_codes::OK) {
+    IMMPP_LOG_WARN("Bad Allocation on ids, reusing the parent id");
+    ++this->state.dropped_ids;
+  }
+}
 
-  set_color(this->renderer, color);
-  SDL_RenderFillRect(this->renderer, (SDL_FRect*)&rectangle);
+void Window::attach_arena() noexcept {
+  this->state.widget_sizes.set_arena(&this->arena);
+  this->state.widgets.set_arena(&this->arena);
+  this->state.ids.set_arena(&this->arena);
+  this->state.scroll_regions.set_arena(&this->arena);
+  this->state.table_columns.set_arena(&this->arena);
+  this->draws.set_arena(&this->arena);
 }
 
 } // namespace immpp
@@ -0,0 +1,94 @@
+#include "./allocations.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <atomic>
+
+namespace {
+
+using immpp::allocations::Subsystem;
+
+struct AtomicCounter {
+  std::atomic<immpp::u64> allocations{0};
+  std::atomic<immpp::u64> bytes{0};
+};
+
+// Hooks can run on any thread, the counters are shared
+std::array<AtomicCounter, immpp::allocations::SUBSYSTEM_COUNT> // NOLINT
+    counters{};
+immpp::allocations::FrameAllocations last_frame{}; // NOLINT
+immpp::u64 allocating_frames = 0;                  // NOLINT
+
+// Trivial types only, so the first access does not allocate
+thread_local Subsystem current = Subsystem::OTHER; // NOLINT
+thread_local immpp::i32 untracked_depth = 0;       // NOLINT
+
+const std::array<const immpp::c8*, immpp::allocations::SUBSYSTEM_COUNT>
+    NAMES{"other", "input", "layout", "draw", "text", "image", "font"};
+
+} // namespace
+
+namespace immpp {
+
+void allocations::record(u64 bytes) noexcept {
+  if (untracked_depth > 0) {
+    return;
+  }
+
+  auto& counter = counters[(i32)current];
+  counter.allocations.fetch_add(1, std::memory_order_relaxed);
+  counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void allocations::begin_frame() noexcept {
+  for (auto& counter : counters) {
+    counter.allocations.store(0, std::memory_order_relaxed);
+    counter.bytes.store(0, std::memory_order_relaxed);
+  }
+}
+
+void allocations::end_frame() noexcept {
+  last_frame.total = {};
+  for (i32 i = 0; i < SUBSYSTEM_COUNT; ++i) {
+    const AtomicCounter& shared = counters[i];
+    Counter& counter = last_frame.subsystems[i];
+    counter.allocations = shared.allocations.load(std::memory_order_relaxed);
+    counter.bytes = shared.bytes.load(std::memory_order_relaxed);
+    last_frame.total.allocations += counter.allocations;
+    last_frame.total.bytes += counter.bytes;
+  }
+
+  if (last_frame.total.allocations > 0) {
+    ++allocating_frames;
+  }
+}
+
+const allocations::FrameAllocations& allocations::get_frame() noexcept {
+  return last_frame;
+}
+
+u64 allocations::get_allocating_frames() noexcept {
+  return allocating_frames;
+}
+
+const c8* allocations::get_name(Subsystem subsystem) noexcept {
+  const i32 index = (i32)subsystem;
+  return index < SUBSYSTEM_COUNT ? NAMES[index] : "unknown";
+}
+
+allocations::Scope::Scope(Subsystem subsystem) noexcept : previous(current) {
+  current = subsystem;
+}
+
+allocations::Scope::~Scope() noexcept {
+  current = this->previous;
+}
+
+allocations::Untracked::Untracked() noexcept {
+  ++untracked_depth;
+}
+
+allocations::Untracked::~Untracked() noexcept {
+  --untracked_depth;
+}
+
+} // namespace immpp
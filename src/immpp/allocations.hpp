@@ -0,0 +1,107 @@
+#ifndef IMMPP_ALLOCATIONS_HPP
+#define IMMPP_ALLOCATIONS_HPP
+
+#include "immpp/types.hpp"
+#include <array>
+
+namespace immpp::allocations {
+
+enum class Subsystem : u8 {
+  OTHER = 0, // Outside any scope, e.g. user code
+  INPUT,
+  LAYOUT,
+  DRAW,
+  TEXT,
+  IMAGE,
+  FONT,
+  COUNT,
+};
+
+const i32 SUBSYSTEM_COUNT = (i32)Subsystem::COUNT;
+
+struct Counter {
+  u64 allocations = 0;
+  u64 bytes = 0;
+};
+
+struct FrameAllocations {
+  std::array<Counter, SUBSYSTEM_COUNT> subsystems{};
+  Counter total{};
+};
+
+/**
+ * Counts an allocation against the subsystem of the innermost scope of the
+ * calling thread. Called by allocator hooks: the SDL memory functions when
+ * IMMPP_TRACK_ALLOCATIONS is defined, or a malloc interposer of the program.
+ * Must not allocate itself.
+ **/
+void record(u64 bytes) noexcept;
+
+// Frames are counted from begin_frame to end_frame
+void begin_frame() noexcept;
+void end_frame() noexcept;
+
+// Last completed frame
+[[nodiscard]] const FrameAllocations& get_frame() noexcept;
+// Frames with at least one allocation since the start
+[[nodiscard]] u64 get_allocating_frames() noexcept;
+[[nodiscard]] const c8* get_name(Subsystem subsystem) noexcept;
+
+class Scope {
+public:
+  explicit Scope(Subsystem subsystem) noexcept;
+  Scope(const Scope&) = delete;
+  Scope(Scope&&) = delete;
+  Scope& operator=(const Scope&) = delete;
+  Scope& operator=(Scope&&) = delete;
+
+  ~Scope() noexcept;
+
+private:
+  Subsystem previous;
+};
+
+// Allocations inside are not recorded, for hooks that forward to an
+// allocator which is hooked as well
+class Untracked {
+public:
+  Untracked() noexcept;
+  Untracked(const Untracked&) = delete;
+  Untracked(Untracked&&) = delete;
+  Untracked& operator=(const Untracked&) = delete;
+  Untracked& operator=(Untracked&&) = delete;
+
+  ~Untracked() noexcept;
+};
+
+} // namespace immpp::allocations
+
+// Compiled in with IMMPP_TRACK_ALLOCATIONS, expands to nothing otherwise
+
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_CONCAT2(a, b) a##b
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_CONCAT(a, b) IMMPP_ALLOC_CONCAT2(a, b)
+
+#ifdef IMMPP_TRACK_ALLOCATIONS
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_SCOPE(subsystem)                                           \
+  const immpp::allocations::Scope IMMPP_ALLOC_CONCAT(                          \
+      immpp_allocations_, __LINE__                                             \
+  ) {                                                                          \
+    immpp::allocations::Subsystem::subsystem                                   \
+  }
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_BEGIN_FRAME() immpp::allocations::begin_frame()
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_END_FRAME() immpp::allocations::end_frame()
+#else
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_SCOPE(subsystem) static_cast<void>(0)
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_BEGIN_FRAME() static_cast<void>(0)
+// NOLINTNEXTLINE
+#define IMMPP_ALLOC_END_FRAME() static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,290 @@
+#include "./binary_log.hpp"
+#include "immpp/hash.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace immpp {
+
+namespace {
+
+const u64 FORMAT_MASK = binary_log::MAX_FORMATS - 1;
+const u64 HEADER_SIZE = (sizeof(binary_log::FileHeader) + 7) & ~7ULL;
+
+u8* mapping = nullptr; // NOLINT
+u64 mapping_size = 0;  // NOLINT
+#ifdef __unix__
+i32 file = -1; // NOLINT
+#elif defined(_WIN32)
+HANDLE file = INVALID_HANDLE_VALUE; // NOLINT
+HANDLE file_mapping = nullptr;      // NOLINT
+#endif
+
+std::atomic<bool> opened{false}; // NOLINT
+std::atomic<u64> offset{0};      // NOLINT
+std::atomic<u64> dropped{0};     // NOLINT
+// Writers between reserve and commit, close waits for them
+std::atomic<i32> writers{0}; // NOLINT
+
+// Open addressing table from the hash of the format contents, the slot is
+// the id. 0 marks an empty slot
+// NOLINTNEXTLINE
+std::array<std::atomic<u64>, binary_log::MAX_FORMATS> formats{};
+
+#ifdef __unix__
+u8* map_file(const c8* path, u64 capacity) noexcept {
+  file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644); // NOLINT
+  if (file < 0) {
+    return nullptr;
+  }
+
+  if (ftruncate(file, static_cast<off_t>(capacity)) != 0) {
+    ::close(file);
+    file = -1;
+    return nullptr;
+  }
+
+  void* memory =
+      mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (memory == MAP_FAILED) { // NOLINT
+    ::close(file);
+    file = -1;
+    return nullptr;
+  }
+  return static_cast<u8*>(memory);
+}
+
+void unmap_file(u64 used) noexcept {
+  munmap(mapping, mapping_size);
+  static_cast<void>(ftruncate(file, static_cast<off_t>(used)));
+  ::close(file);
+  file = -1;
+}
+#elif defined(_WIN32)
+u8* map_file(const c8* path, u64 capacity) noexcept {
+  file = CreateFileA(
+      path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+      CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+  );
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+
+  // Mapping past the end extends the file with zeros
+  file_mapping = CreateFileMappingA(
+      file, nullptr, PAGE_READWRITE, static_cast<DWORD>(capacity >> 32),
+      static_cast<DWORD>(capacity & 0xffff'ffff), nullptr
+  );
+  if (file_mapping == nullptr) {
+    CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+    return nullptr;
+  }
+
+  void* memory = MapViewOfFile(file_mapping, FILE_MAP_WRITE, 0, 0, capacity);
+  if (memory == nullptr) {
+    CloseHandle(file_mapping);
+    CloseHandle(file);
+    file_mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+    return nullptr;
+  }
+  return static_cast<u8*>(memory);
+}
+
+void unmap_file(u64 used) noexcept {
+  UnmapViewOfFile(mapping);
+  CloseHandle(file_mapping);
+  file_mapping = nullptr;
+
+  // The file can only be truncated once no mapping is left
+  LARGE_INTEGER size{};
+  size.QuadPart = static_cast<LONGLONG>(used);
+  if (SetFilePointerEx(file, size, nullptr, FILE_BEGIN) != 0) {
+    static_cast<void>(SetEndOfFile(file));
+  }
+  CloseHandle(file);
+  file = INVALID_HANDLE_VALUE;
+}
+#else
+u8* map_file(const c8* path, u64 capacity) noexcept {
+  static_cast<void>(path);
+  static_cast<void>(capacity);
+  return nullptr;
+}
+
+void unmap_file(u64 used) noexcept {
+  static_cast<void>(used);
+}
+#endif
+
+void write_format(u32 id, const c8* format, u8 level) noexcept {
+  const u64 length = std::strlen(format) + 1;
+  const u32 size = (sizeof(binary_log::RecordHeader) + length + 7) & ~7ULL;
+
+  u8* record = binary_log::reserve(size);
+  if (record == nullptr) {
+    return;
+  }
+
+  std::memcpy(record + sizeof(binary_log::RecordHeader), format, length);
+  binary_log::commit(
+      record, binary_log::RecordHeader{
+                  .time = binary_log::get_time(),
+                  .size = size,
+                  .format = id,
+                  .kind = binary_log::RecordKind::FORMAT,
+                  .level = level,
+              }
+  );
+}
+
+} // namespace
+
+opt_error binary_log::open(const c8* path, u64 capacity) noexcept {
+  close();
+
+  mapping = map_file(path, capacity);
+  if (mapping == nullptr) {
+    return opt_error{error_codes::UNKNOWN};
+  }
+  mapping_size = capacity;
+
+  FileHeader header{};
+  std::memcpy(header.magic, "IMMPPLOG", sizeof header.magic);
+  header.version = VERSION;
+  header.header_size = HEADER_SIZE;
+  header.capacity = capacity;
+  header.steady_time = get_time();
+  header.wall_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()
+      )
+          .count();
+  std::memcpy(mapping, &header, sizeof header);
+
+  for (auto& format : formats) {
+    format.store(0, std::memory_order_relaxed);
+  }
+  offset.store(HEADER_SIZE, std::memory_order_relaxed);
+  dropped.store(0, std::memory_order_relaxed);
+  opened.store(true, std::memory_order_release);
+  return ds::null;
+}
+
+void binary_log::close() noexcept {
+  if (!opened.exchange(false)) {
+    return;
+  }
+
+  // Sequentially consistent with reserve, a writer either sees the log
+  // closed or is waited for here before the mapping goes away
+  while (writers.load() != 0) {
+    std::this_thread::yield();
+  }
+
+  const u64 used =
+      std::min(offset.load(std::memory_order_relaxed), mapping_size);
+  const u64 dropped_count = dropped.load(std::memory_order_relaxed);
+  std::memcpy(
+      mapping + offsetof(FileHeader, dropped), &dropped_count,
+      sizeof dropped_count
+  );
+  unmap_file(used);
+
+  mapping = nullptr;
+  mapping_size = 0;
+}
+
+bool binary_log::is_open() noexcept {
+  return opened.load(std::memory_order_relaxed);
+}
+
+u64 binary_log::get_dropped() noexcept {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+i32 binary_log::get_format_id(const c8* format, u8 level) noexcept {
+  // Keyed by the contents, a reused buffer gets the id of what it holds now
+  u64 key = hash::string(format);
+  key = key == 0 ? 1 : key;
+  u64 index = key & FORMAT_MASK;
+  for (i32 probe = 0; probe < MAX_FORMATS; ++probe) {
+    u64 current = formats[index].load(std::memory_order_acquire);
+    if (current == key) {
+      return static_cast<i32>(index);
+    }
+
+    if (current == 0) {
+      if (formats[index].compare_exchange_strong(
+              current, key, std::memory_order_acq_rel
+          )) {
+        write_format(index, format, level);
+        return static_cast<i32>(index);
+      }
+      if (current == key) {
+        return static_cast<i32>(index);
+      }
+    }
+
+    index = (index + 1) & FORMAT_MASK;
+  }
+
+  dropped.fetch_add(1, std::memory_order_relaxed);
+  return -1;
+}
+
+u8* binary_log::reserve(u32 size) noexcept {
+  writers.fetch_add(1);
+  if (!opened.load()) {
+    writers.fetch_sub(1, std::memory_order_release);
+    return nullptr;
+  }
+
+  const u64 start = offset.fetch_add(size, std::memory_order_relaxed);
+  if (start + size > mapping_size) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    writers.fetch_sub(1, std::memory_order_release);
+    return nullptr;
+  }
+
+  // The size lets the decoder skip a record that is never committed
+  u8* record = mapping + start;
+  const RecordHeader header{
+      .time = 0,
+      .size = size,
+      .format = 0,
+      .kind = RecordKind::RESERVED,
+      .level = 0,
+  };
+  std::memcpy(record, &header, sizeof header);
+  return record;
+}
+
+void binary_log::commit(u8* record, RecordHeader header) noexcept {
+  std::memcpy(record, &header, sizeof header);
+  writers.fetch_sub(1, std::memory_order_release);
+}
+
+u64 binary_log::get_time() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()
+  )
+      .count();
+}
+
+} // namespace immpp
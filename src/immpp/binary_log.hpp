@@ -0,0 +1,173 @@
+#ifndef IMMPP_BINARY_LOG_HPP
+#define IMMPP_BINARY_LOG_HPP
+
+#include "immpp/types.hpp"
+#include <cstring>
+#include <type_traits>
+
+namespace immpp::binary_log {
+
+// === File Format === //
+
+const u32 VERSION = 1;
+const u64 DEFAULT_CAPACITY = 64ULL * 1024 * 1024;
+const i32 MAX_FORMATS = 4096; // Power of 2
+const u64 MAX_STRING = 1024;  // Longer string arguments are truncated
+
+struct FileHeader {
+  c8 magic[8]; // NOLINT, "IMMPPLOG"
+  u32 version;
+  u32 header_size;
+  u64 capacity;    // File size while it is open
+  u64 wall_time;   // ns since the epoch at steady_time
+  u64 steady_time; // ns, records are in the same clock
+  u64 dropped;     // Written on close
+};
+
+enum class RecordKind : u8 {
+  END = 0, // Zero filled space past the last record
+  FORMAT = 1,
+  MESSAGE = 2,
+  RESERVED = 3, // Not committed before the file was closed, skipped
+};
+
+// Records are 8 byte aligned, a FORMAT record is followed by the zero
+// terminated format string and a MESSAGE record by its arguments
+struct RecordHeader {
+  u64 time;   // ns
+  u32 size;   // Whole record
+  u32 format; // Format id
+  RecordKind kind;
+  u8 level; // LogLevel
+};
+
+// Argument tags, followed by the raw value
+enum class ArgumentKind : u8 {
+  SIGNED = 'i',   // i64
+  UNSIGNED = 'u', // u64
+  FLOAT = 'f',    // f64
+  STRING = 's',   // u16 length and the bytes
+  POINTER = 'p',  // u64
+};
+
+// === Writer === //
+
+/**
+ * Messages logged through the IMMPP_LOG_* macros are stored in a memory
+ * mapped file while it is open, formatting is left to immpp_log_decoder.
+ * Messages are dropped once the file is full.
+ *
+ * Possible errors:
+ * - UNKNOWN, the file could not be created or mapped
+ **/
+[[nodiscard]] opt_error
+open(const c8* path, u64 capacity = DEFAULT_CAPACITY) noexcept;
+// Truncates the file to the written records
+void close() noexcept;
+[[nodiscard]] bool is_open() noexcept;
+[[nodiscard]] u64 get_dropped() noexcept;
+
+// Returns the id of the format, -1 if there is no room. The format is
+// identified by its contents, so reused buffers keep their own ids.
+[[nodiscard]] i32 get_format_id(const c8* format, u8 level) noexcept;
+// Returns nullptr if the file is full, otherwise commit must follow. close
+// waits for the reserved records to be committed
+[[nodiscard]] u8* reserve(u32 size) noexcept;
+void commit(u8* record, RecordHeader header) noexcept;
+[[nodiscard]] u64 get_time() noexcept;
+
+// === Arguments === //
+
+template <typename T> constexpr bool IS_STRING_V =
+    std::is_pointer_v<T> &&
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, c8>;
+
+[[nodiscard]] inline u16 get_string_length(const c8* string) noexcept {
+  const u64 length = string == nullptr ? 0 : std::strlen(string);
+  return static_cast<u16>(length < MAX_STRING ? length : MAX_STRING);
+}
+
+template <typename T>
+[[nodiscard]] u32 get_argument_size([[maybe_unused]] T value) noexcept {
+  static_assert(
+      std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>,
+      "Unsupported log argument"
+  );
+
+  if constexpr (IS_STRING_V<T>) {
+    return 1 + sizeof(u16) + get_string_length(value);
+  } else {
+    return 1 + 8;
+  }
+}
+
+[[nodiscard]] inline u8*
+write_value(u8* cursor, ArgumentKind kind, const void* value) noexcept {
+  *cursor = static_cast<u8>(kind);
+  std::memcpy(cursor + 1, value, 8);
+  return cursor + 1 + 8;
+}
+
+template <typename T>
+[[nodiscard]] u8* write_argument(u8* cursor, T value) noexcept {
+  if constexpr (IS_STRING_V<T>) {
+    const u16 length = get_string_length(value);
+    *cursor = static_cast<u8>(ArgumentKind::STRING);
+    std::memcpy(cursor + 1, &length, sizeof length);
+    if (length > 0) {
+      std::memcpy(cursor + 1 + sizeof length, value, length);
+    }
+    return cursor + 1 + sizeof length + length;
+  } else if constexpr (std::is_enum_v<T>) {
+    return write_argument(
+        cursor, static_cast<std::underlying_type_t<T>>(value)
+    );
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const f64 converted = value;
+    return write_value(cursor, ArgumentKind::FLOAT, &converted);
+  } else if constexpr (std::is_pointer_v<T>) {
+    const u64 converted = reinterpret_cast<u64>(value); // NOLINT
+    return write_value(cursor, ArgumentKind::POINTER, &converted);
+  } else if constexpr (std::is_signed_v<T>) {
+    const i64 converted = value;
+    return write_value(cursor, ArgumentKind::SIGNED, &converted);
+  } else {
+    const u64 converted = value;
+    return write_value(cursor, ArgumentKind::UNSIGNED, &converted);
+  }
+}
+
+// Stores the format id, a timestamp and the raw arguments
+template <typename... Args>
+void write(u8 level, const c8* format, const Args&... args) noexcept {
+  const i32 id = get_format_id(format, level);
+  if (id < 0) {
+    return;
+  }
+
+  u32 size = sizeof(RecordHeader) + (0 + ... + get_argument_size(args));
+  size = (size + 7) & ~7U;
+
+  u8* record = reserve(size);
+  if (record == nullptr) {
+    return;
+  }
+
+  u8* cursor = record + sizeof(RecordHeader);
+  ((cursor = write_argument(cursor, args)), ...);
+  static_cast<void>(cursor);
+
+  commit(
+      record, RecordHeader{
+                  .time = get_time(),
+                  .size = size,
+                  .format = static_cast<u32>(id),
+                  .kind = RecordKind::MESSAGE,
+                  .level = level,
+              }
+  );
+}
+
+} // namespace immpp::binary_log
+
+#endif
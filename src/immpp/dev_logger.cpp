@@ -1,7 +1,13 @@
 #include "./logger.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
 #include <ctime>
+#include <mutex>
+#include <thread>
 
 namespace immpp {
 
@@ -59,129 +65,351 @@ const char* const DEBUG_LABEL = "debug";
 
 const char* const TIMESTAMP_FMT = "YYYY-MM-DDTHH:mm:ss.SSS";
 const i32 TIMESTAMP_LENGTH = sizeof "YYYY-MM-DDTHH:mm:ss.SSS";
-char timestamp[TIMESTAMP_LENGTH]; // NOLINT
 
 namespace {
 
-// NOLINTNEXTLINE
-inline static LogLevel level = LogLevel::DEBUG;
+// Set from any thread, read by every producer
+std::atomic<LogLevel> level{LogLevel::DEBUG}; // NOLINT
+
+struct LevelStyle {
+  const char* label;
+  const char* foreground;
+  const char* background;
+};
+
+// Indexed by LogLevel
+const std::array<LevelStyle, 6> STYLES{
+  LevelStyle{"", "", ""},
+  LevelStyle{FATAL_LABEL, TEXT_BLACK, BG_RED},
+  LevelStyle{ERROR_LABEL, TEXT_RED, ""},
+  LevelStyle{WARN_LABEL, TEXT_YELLOW, ""},
+  LevelStyle{INFO_LABEL, TEXT_GREEN, ""},
+  LevelStyle{DEBUG_LABEL, TEXT_VIOLET, ""},
+};
+
+// Wakes up the writer even if a notification was missed
+const auto WRITER_TIMEOUT = std::chrono::milliseconds(10);
+
+// === Queue === //
+
+// The slot at position p is free for producers when its sequence is p and
+// ready for the writer when it is p + 1
+struct Record {
+  std::atomic<u64> sequence{0};
+  LogLevel level = LogLevel::SILENT;
+  tv time{};
+  char message[logger::MESSAGE_SIZE]{}; // NOLINT
+};
+
+const u64 MASK = logger::QUEUE_CAPACITY - 1;
 
-// NOTE: No multi-threading is done, yet
-/* std::mutex mutex{}; */
+// NOLINTNEXTLINE
+std::array<Record, logger::QUEUE_CAPACITY> records{};
+std::atomic<u64> tail{0};      // NOLINT, next position for producers
+std::atomic<u64> head{0};      // NOLINT, next position for the writer
+std::atomic<u64> dropped{0};   // NOLINT
+std::atomic<bool> async{false}; // NOLINT
+
+std::thread writer{};                  // NOLINT
+std::atomic<bool> writer_running{false}; // NOLINT
+std::atomic<bool> writer_sleeping{false}; // NOLINT
+std::mutex writer_mutex{};              // NOLINT
+std::condition_variable writer_wake{};  // NOLINT
+std::condition_variable writer_drained{}; // NOLINT, head moved, for flush
 
-const char* get_timestamp() noexcept {
-  tv current = {};
-  gettimeofday(&current, nullptr);
+// === Utils === //
 
+void format_timestamp(char* buffer, const tv& time) noexcept {
   static_cast<void>(strftime(
-      timestamp, TIMESTAMP_LENGTH, "%Y-%m-%dT%H:%M:%S",
-      localtime(&current.tv_sec) // NOLINT
+      buffer, TIMESTAMP_LENGTH, "%Y-%m-%dT%H:%M:%S",
+      localtime(&time.tv_sec) // NOLINT
   ));
-  timestamp[sizeof "YYYY-MM-DDTHH:mm:ss"] = '\0';
 
+  const i32 offset = sizeof "YYYY-MM-DDTHH:mm:ss" - 1;
   // NOLINTNEXTLINE
-  sprintf(timestamp, "%s.%03ld", timestamp, current.tv_usec / 1000);
-  return timestamp;
+  snprintf(
+      buffer + offset, TIMESTAMP_LENGTH - offset, ".%03u",
+      static_cast<u32>(time.tv_usec / 1000) % 1000
+  );
 }
 
-// === Utils === //
-inline void print_header(
-    const char* level, const char* level_fg, const char* level_bg
-) noexcept {
+inline void print_header(LogLevel message_level, const tv& time) noexcept {
+  char timestamp[TIMESTAMP_LENGTH]; // NOLINT
+  format_timestamp(timestamp, time);
+
+  const LevelStyle& style = STYLES[message_level];
   printf(
-      "%s %s%s%s%s:%s ", get_timestamp(), TEXT_BOLD, level_fg, level_bg, level,
-      RESET
+      "%s %s%s%s%s:%s ", timestamp, TEXT_BOLD, style.foreground,
+      style.background, style.label, RESET
   );
 }
 
-inline void print_header(const char* level, const char* level_fg) noexcept {
-  printf("%s %s%s%s:%s ", get_timestamp(), TEXT_BOLD, level_fg, level, RESET);
+void print(LogLevel message_level, const c8* message, va_list args) noexcept {
+  tv time = {};
+  gettimeofday(&time, nullptr);
+
+  print_header(message_level, time);
+  vprintf(message, args);
+  printf("\n");
+}
+
+[[nodiscard]] bool push(
+    LogLevel message_level, const c8* message, va_list args
+) noexcept {
+  u64 position = tail.load(std::memory_order_relaxed);
+  Record* record = nullptr;
+  while (true) {
+    record = &records[position & MASK];
+    const u64 sequence = record->sequence.load(std::memory_order_acquire);
+
+    if (sequence == position) {
+      if (tail.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed
+          )) {
+        break;
+      }
+    } else if (sequence < position) {
+      // Full, the writer has not freed the slot yet
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  record->level = message_level;
+  gettimeofday(&record->time, nullptr);
+  vsnprintf(record->message, logger::MESSAGE_SIZE, message, args);
+  record->sequence.store(position + 1, std::memory_order_release);
+
+  if (writer_sleeping.load(std::memory_order_acquire)) {
+    writer_wake.notify_one();
+  }
+  return true;
+}
+
+// Only called from the writer thread, returns true if anything was written
+bool drain() noexcept {
+  u64 position = head.load(std::memory_order_relaxed);
+  const u64 first = position;
+
+  while (true) {
+    Record& record = records[position & MASK];
+    if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+      break;
+    }
+
+    print_header(record.level, record.time);
+    printf("%s\n", record.message);
+
+    record.sequence.store(
+        position + logger::QUEUE_CAPACITY, std::memory_order_release
+    );
+    head.store(++position, std::memory_order_release);
+  }
+
+  if (position == first) {
+    return false;
+  }
+  fflush(stdout);
+
+  // Taking the mutex orders the notification after a waiting flush checks
+  {
+    const std::lock_guard<std::mutex> lock{writer_mutex};
+  }
+  writer_drained.notify_all();
+  return true;
+}
+
+[[nodiscard]] bool has_pending() noexcept {
+  const u64 position = head.load(std::memory_order_relaxed);
+  return records[position & MASK].sequence.load(std::memory_order_acquire) ==
+         position + 1;
+}
+
+void run_writer() noexcept {
+  while (writer_running.load(std::memory_order_acquire)) {
+    if (drain()) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock{writer_mutex};
+    writer_sleeping.store(true, std::memory_order_release);
+    writer_wake.wait_for(lock, WRITER_TIMEOUT, [] {
+      return has_pending() || !writer_running.load(std::memory_order_acquire);
+    });
+    writer_sleeping.store(false, std::memory_order_release);
+  }
+
+  drain();
+}
+
+void stop_writer() noexcept {
+  async.store(false, std::memory_order_release);
+  if (!writer.joinable()) {
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock{writer_mutex};
+    writer_running.store(false, std::memory_order_release);
+  }
+  writer_wake.notify_one();
+  writer_drained.notify_all();
+  writer.join();
+}
+
+// Joins the writer before the static destructors run
+struct WriterGuard {
+  WriterGuard() noexcept = default;
+  WriterGuard(const WriterGuard&) = delete;
+  WriterGuard(WriterGuard&&) = delete;
+  WriterGuard& operator=(const WriterGuard&) = delete;
+  WriterGuard& operator=(WriterGuard&&) = delete;
+
+  ~WriterGuard() noexcept {
+    stop_writer();
+  }
+};
+const WriterGuard writer_guard{}; // NOLINT
+
+void log(LogLevel message_level, const c8* message, va_list args) noexcept {
+  if (async.load(std::memory_order_acquire)) {
+    va_list queued_args;
+    va_copy(queued_args, args);
+    const bool queued = push(message_level, message, queued_args);
+    va_end(queued_args);
+    if (queued) {
+      return;
+    }
+
+    // Dropped, still make sure a fatal message gets out
+    if (message_level != LogLevel::FATAL) {
+      return;
+    }
+    logger::flush();
+  }
+
+  print(message_level, message, args);
 }
 
 } // namespace
 
 void logger::set_level(LogLevel new_level) noexcept {
-  level = new_level;
+  level.store(new_level, std::memory_order_relaxed);
+}
+
+LogLevel logger::get_level() noexcept {
+  return level.load(std::memory_order_relaxed);
+}
+
+void logger::set_async(bool enabled) noexcept {
+  if (!enabled) {
+    stop_writer();
+    return;
+  }
+
+  if (writer.joinable()) {
+    return;
+  }
+
+  // The queue is empty, restart the positions
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+  for (i32 i = 0; i < QUEUE_CAPACITY; ++i) {
+    records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  fflush(stdout);
+  writer_running.store(true, std::memory_order_release);
+  writer = std::thread{run_writer};
+  async.store(true, std::memory_order_release);
+}
+
+void logger::flush() noexcept {
+  if (writer.joinable()) {
+    const u64 position = tail.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock{writer_mutex};
+    writer_wake.notify_one();
+    writer_drained.wait(lock, [position] {
+      return head.load(std::memory_order_acquire) >= position ||
+             !writer_running.load(std::memory_order_acquire);
+    });
+  }
+
+  fflush(stdout);
+}
+
+u64 logger::get_dropped() noexcept {
+  return dropped.load(std::memory_order_relaxed);
 }
 
 // === Fatal === //
 // NOLINTNEXTLINE
 void logger::fatal(const c8* message, ...) noexcept {
-  if (level < LogLevel::FATAL) {
+  if (get_level() < LogLevel::FATAL) {
     return;
   }
 
-  print_header(FATAL_LABEL, TEXT_BLACK, BG_RED);
-
   va_list args;
   va_start(args, message);
-  vprintf(message, args);
+  log(LogLevel::FATAL, message, args);
   va_end(args);
-  printf("\n");
+
+  // Usually followed by an abort
+  flush();
 }
 
 // === Error === //
 // NOLINTNEXTLINE
 void logger::error(const c8* message, ...) noexcept {
-  if (level < LogLevel::ERROR) { // ERROR is defined in Windows
+  if (get_level() < LogLevel::ERROR) { // ERROR is defined in Windows
     return;
   }
 
-  print_header(ERROR_LABEL, TEXT_RED);
-
   va_list args;
   va_start(args, message);
-  vprintf(message, args);
+  log(LogLevel::ERROR, message, args);
   va_end(args);
-  printf("\n");
 }
 
 // === WARN === //
 // NOLINTNEXTLINE
 void logger::warn(const c8* message, ...) noexcept {
-  if (level < LogLevel::WARN) {
+  if (get_level() < LogLevel::WARN) {
     return;
   }
 
-  print_header(WARN_LABEL, TEXT_YELLOW);
-
   va_list args;
   va_start(args, message);
-  vprintf(message, args);
+  log(LogLevel::WARN, message, args);
   va_end(args);
-  printf("\n");
 }
 
 // === INFO === //
 // NOLINTNEXTLINE
 void logger::info(const c8* message, ...) noexcept {
-  if (level < LogLevel::INFO) {
+  if (get_level() < LogLevel::INFO) {
     return;
   }
 
-  print_header(INFO_LABEL, TEXT_GREEN);
-
   va_list args;
   va_start(args, message);
-  vprintf(message, args);
+  log(LogLevel::INFO, message, args);
   va_end(args);
-  printf("\n");
 }
 
 // === DEBUG === //
 // NOLINTNEXTLINE
 void logger::debug(const c8* message, ...) noexcept {
-  if (level < LogLevel::DEBUG) {
+  if (get_level() < LogLevel::DEBUG) {
     return;
   }
 
-  print_header(DEBUG_LABEL, TEXT_VIOLET);
-
   va_list args;
   va_start(args, message);
-  vprintf(message, args);
+  log(LogLevel::DEBUG, message, args);
   va_end(args);
-  printf("\n");
 }
 
 } // namespace immpp
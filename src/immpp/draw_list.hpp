@@ -0,0 +1,104 @@
+#ifndef IMMPP_DRAW_LIST_HPP
+#define IMMPP_DRAW_LIST_HPP
+
+#include "SDL3/SDL_rect.h"
+#include "SDL3/SDL_render.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/frame_arena.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct DrawListStats {
+  i32 quads = 0;
+  i32 batches = 0;
+  i32 sdl_calls = 0; // Including the clear and present
+};
+
+// Per frame list of quads submitted as SDL_RenderGeometry batches.
+// Every primitive is a quad, so solid fills and outlines of any color share
+// one batch. A quad can join an earlier batch with the same texture and clip
+// rect as long as it does not overlap anything queued after that batch.
+class DrawList {
+public:
+  DrawList() noexcept = default;
+  DrawList(DrawList&& other) noexcept = default;
+  DrawList& operator=(DrawList&& rhs) noexcept = default;
+
+  DrawList(const DrawList&) = delete;
+  DrawList& operator=(const DrawList&) = delete;
+
+  ~DrawList() noexcept = default;
+
+  // === Commands === //
+
+  void fill_rectangle(const SDL_FRect& rectangle, rgba8 color) noexcept;
+  void rectangle(const SDL_FRect& rectangle, rgba8 color) noexcept;
+  void texture(SDL_Texture* texture, const SDL_FRect& rectangle) noexcept;
+  // uv is in normalized texture coordinates
+  void textured_quad(
+      SDL_Texture* texture, const SDL_FRect& rectangle, const SDL_FRect& uv,
+      rgba8 color
+  ) noexcept;
+  // Drawn right away under the active clip, flushing the queued quads first
+  void
+  text(SDL_Renderer* renderer, TTF_Text* text, vec2<f32> position) noexcept;
+  // nullptr disables clipping
+  void set_clip(const SDL_Rect* clip) noexcept;
+
+  // Backs the queued commands with the frame arena, call between frames
+  void set_arena(FrameArena* arena) noexcept;
+
+  // === Frame === //
+
+  // Starts a new frame by clearing the render target, untextured quads are
+  // alpha blended
+  void clear(SDL_Renderer* renderer, rgba8 color) noexcept;
+  // Submits everything queued so far, can be called mid frame
+  void flush(SDL_Renderer* renderer) noexcept;
+  // Flushes and presents the frame
+  void present(SDL_Renderer* renderer) noexcept;
+
+  // Stats of the last presented frame
+  [[nodiscard]] const DrawListStats& get_stats() const noexcept;
+
+private:
+  struct Clip {
+    SDL_Rect rect;
+    bool enabled;
+  };
+
+  struct Batch {
+    SDL_Texture* texture;
+    SDL_FRect bounds;
+    i32 clip;
+    i32 first; // First quad of the batch
+    i32 last;  // Last quad of the batch
+  };
+
+  FrameVector<SDL_Vertex> vertices{};
+  FrameVector<i32> next_quads{}; // Links quads of the same batch
+  FrameVector<i32> indices{};
+  FrameVector<Batch> batches{};
+  FrameVector<Clip> clips{};
+
+  // Batches before this index have a different clip rect
+  i32 clip_start = 0;
+
+  DrawListStats frame{};
+  DrawListStats last_frame{};
+
+  void push_quad(
+      SDL_Texture* texture, const SDL_FRect& rectangle, const SDL_FRect& uv,
+      const SDL_FColor& color
+  ) noexcept;
+  [[nodiscard]] i32 find_batch(
+      SDL_Texture* texture, const SDL_FRect& rectangle
+  ) const noexcept;
+  // Index of the active clip, -1 if the clips could not grow
+  [[nodiscard]] i32 get_clip() noexcept;
+};
+
+} // namespace immpp
+
+#endif
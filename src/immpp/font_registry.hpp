@@ -0,0 +1,70 @@
+#ifndef IMMPP_FONT_REGISTRY_HPP
+#define IMMPP_FONT_REGISTRY_HPP
+
+#include "SDL3_ttf/SDL_ttf.h"
+#include "ds/vector.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+using FontHandle = i32;
+const FontHandle INVALID_FONT = -1;
+
+struct FontFaceStats {
+  const c8* path = nullptr;
+  u64 bytes = 0; // Font file kept in memory, shared by all its sizes
+  i32 sizes = 0; // Opened sizes of the face
+};
+
+// Each font file is read once, its sizes are opened from the same memory
+// and stay valid until the registry is cleared
+class FontRegistry {
+public:
+  FontRegistry() noexcept = default;
+  FontRegistry(FontRegistry&& other) noexcept = default;
+  FontRegistry& operator=(FontRegistry&& rhs) noexcept;
+
+  FontRegistry(const FontRegistry&) = delete;
+  FontRegistry& operator=(const FontRegistry&) = delete;
+
+  ~FontRegistry() noexcept;
+
+  /**
+   * Returns the handle of the face at the size, opening it on a miss.
+   * Returns INVALID_FONT if the font could not be loaded.
+   **/
+  [[nodiscard]] FontHandle load(const c8* path, i32 size) noexcept;
+  // nullptr for INVALID_FONT
+  [[nodiscard]] TTF_Font* get(FontHandle handle) const noexcept;
+  void clear() noexcept;
+
+  [[nodiscard]] i32 get_face_count() const noexcept;
+  [[nodiscard]] FontFaceStats get_face_stats(i32 face) const noexcept;
+  // Sum of the font files kept in memory
+  [[nodiscard]] u64 get_bytes() const noexcept;
+
+private:
+  struct Face {
+    u64 hash;
+    c8* path;
+    void* data; // Whole font file
+    u64 bytes;
+    i32 sizes;
+  };
+
+  struct Font {
+    i32 face;
+    i32 size;
+    TTF_Font* font;
+  };
+
+  ds::vector<Face> faces{};
+  ds::vector<Font> fonts{};
+
+  [[nodiscard]] i32 find_face(u64 hash, const c8* path) const noexcept;
+  [[nodiscard]] i32 load_face(u64 hash, const c8* path) noexcept;
+};
+
+} // namespace immpp
+
+#endif
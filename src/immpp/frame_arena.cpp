@@ -0,0 +1,192 @@
+#include "./frame_arena.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Keeps the memory after the overflow header aligned
+const immpp::u64 HEADER_SIZE = 32;
+
+[[nodiscard]] inline immpp::u64
+align_up(immpp::u64 value, immpp::u64 alignment) noexcept {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+namespace immpp {
+
+FrameArena::FrameArena(FrameArena&& other) noexcept
+    : block(other.block), offset(other.offset), overflows(other.overflows),
+      generation(other.generation), next_capacity(other.next_capacity),
+      stats(other.stats) {
+  other.block = nullptr;
+  other.overflows = nullptr;
+  // Vectors of the other arena see their buffers as stale
+  ++other.generation;
+}
+
+FrameArena& FrameArena::operator=(FrameArena&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  std::free(this->block);
+  this->free_overflows();
+  this->block = rhs.block;
+  this->offset = rhs.offset;
+  this->overflows = rhs.overflows;
+  this->generation = std::max(this->generation, rhs.generation) + 1;
+  this->next_capacity = rhs.next_capacity;
+  this->stats = rhs.stats;
+  rhs.block = nullptr;
+  rhs.overflows = nullptr;
+  ++rhs.generation;
+
+  return *this;
+}
+
+FrameArena::~FrameArena() noexcept {
+  std::free(this->block);
+  this->block = nullptr;
+  this->free_overflows();
+}
+
+void* FrameArena::allocate(u64 bytes, u64 alignment) noexcept {
+  assert(alignment <= ALIGNMENT && (alignment & (alignment - 1)) == 0);
+
+  if (this->block == nullptr && this->offset == 0) {
+    // Stays nullptr on failure, the overflow blocks take over
+    this->block = (u8*)std::malloc(this->stats.capacity);
+  }
+
+  const u64 start = align_up(this->offset, alignment);
+  if (this->block != nullptr && start + bytes <= this->stats.capacity) {
+    this->stats.used += start + bytes - this->offset;
+    this->offset = start + bytes;
+    return this->block + start;
+  }
+
+  return this->allocate_overflow(bytes, alignment);
+}
+
+const c8* FrameArena::copy_string(const c8* text, i32 length) noexcept {
+  auto* copy = (c8*)this->allocate(length + 1, 1);
+  if (copy == nullptr) {
+    return nullptr;
+  }
+
+  std::memcpy(copy, text, length);
+  copy[length] = '\0';
+  return copy;
+}
+
+const c8* FrameArena::format(const c8* format, ...) noexcept {
+  va_list args;
+  va_start(args, format);
+  const c8* output = this->format(format, args);
+  va_end(args);
+  return output;
+}
+
+const c8* FrameArena::format(const c8* format, va_list args) noexcept {
+  va_list copy;
+  va_copy(copy, args);
+  const i32 length = std::vsnprintf(nullptr, 0, format, copy);
+  va_end(copy);
+  if (length < 0) {
+    return nullptr;
+  }
+
+  auto* output = (c8*)this->allocate(length + 1, 1);
+  if (output == nullptr) {
+    return nullptr;
+  }
+
+  std::vsnprintf(output, length + 1, format, args);
+  return output;
+}
+
+void FrameArena::reset() noexcept {
+  this->stats.last_used = this->stats.used;
+  this->stats.high_water = std::max(this->stats.high_water, this->stats.used);
+
+  if (this->next_capacity != 0) {
+    this->free_overflows();
+    std::free(this->block);
+    this->block = nullptr;
+    this->stats.capacity = this->next_capacity;
+    this->next_capacity = 0;
+  } else if (this->overflows != nullptr) {
+    this->free_overflows();
+
+    // One allocation now instead of overflowing every frame
+    u64 capacity = std::max(this->stats.capacity, ALIGNMENT);
+    while (capacity < this->stats.used) {
+      capacity <<= 1;
+    }
+    std::free(this->block);
+    this->block = nullptr;
+    this->stats.capacity = capacity;
+    ++this->stats.grows;
+  }
+
+  this->offset = 0;
+  this->stats.used = 0;
+  ++this->generation;
+}
+
+void FrameArena::set_capacity(u64 bytes) noexcept {
+  this->next_capacity = std::max(bytes, ALIGNMENT);
+}
+
+u32 FrameArena::get_generation() const noexcept {
+  return this->generation;
+}
+
+const FrameArenaStats& FrameArena::get_stats() const noexcept {
+  return this->stats;
+}
+
+// === Private === //
+
+void* FrameArena::allocate_overflow(u64 bytes, u64 alignment) noexcept {
+  static_assert(sizeof(Overflow) <= HEADER_SIZE);
+  Overflow* current = this->overflows;
+  if (current != nullptr) {
+    const u64 start = align_up(current->offset, alignment);
+    if (start + bytes <= current->size) {
+      this->stats.used += start + bytes - current->offset;
+      current->offset = start + bytes;
+      return (u8*)current + HEADER_SIZE + start;
+    }
+  }
+
+  // Sized like the arena so small allocations share a block
+  const u64 size = std::max(bytes, this->stats.capacity);
+  auto* overflow = (Overflow*)std::malloc(HEADER_SIZE + size);
+  if (overflow == nullptr) {
+    return nullptr;
+  }
+
+  *overflow = Overflow{.next = this->overflows, .size = size, .offset = bytes};
+  this->overflows = overflow;
+  this->stats.used += bytes;
+  ++this->stats.overflows;
+  return (u8*)overflow + HEADER_SIZE;
+}
+
+void FrameArena::free_overflows() noexcept {
+  while (this->overflows != nullptr) {
+    Overflow* next = this->overflows->next;
+    std::free(this->overflows);
+    this->overflows = next;
+  }
+}
+
+} // namespace immpp
@@ -0,0 +1,274 @@
+#ifndef IMMPP_FRAME_ARENA_HPP
+#define IMMPP_FRAME_ARENA_HPP
+
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace immpp {
+
+struct FrameArenaStats {
+  u64 capacity = 0;
+  u64 used = 0;       // Current frame, overflow included
+  u64 last_used = 0;  // Last finished frame
+  u64 high_water = 0; // Most bytes a frame used
+  u64 overflows = 0;  // Heap blocks taken when the arena was full
+  u64 grows = 0;
+};
+
+// Bump allocator for memory that lives until the end of the frame. When it
+// is full, allocations go to heap blocks and the next reset grows the arena
+// to what the frame used, so steady state frames do not touch the heap.
+class FrameArena {
+public:
+  static const u64 DEFAULT_CAPACITY = 64 * 1024;
+  static constexpr u64 ALIGNMENT = 16; // Largest supported alignment
+
+  FrameArena() noexcept = default;
+  FrameArena(FrameArena&& other) noexcept;
+  FrameArena& operator=(FrameArena&& rhs) noexcept;
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  ~FrameArena() noexcept;
+
+  // Valid until the next reset, nullptr only if the heap is exhausted
+  [[nodiscard]] void* allocate(u64 bytes, u64 alignment = ALIGNMENT) noexcept;
+  // Null terminated copies, valid until the next reset
+  [[nodiscard]] const c8* copy_string(const c8* text, i32 length) noexcept;
+  [[nodiscard]] const c8* format(const c8* format, ...) noexcept;
+  [[nodiscard]] const c8* format(const c8* format, va_list args) noexcept;
+
+  // Releases every allocation, call once per frame
+  void reset() noexcept;
+  // Takes effect on the next reset, the block is allocated on first use
+  void set_capacity(u64 bytes) noexcept;
+
+  // Changes on every reset, allocations of older generations are invalid
+  [[nodiscard]] u32 get_generation() const noexcept;
+  [[nodiscard]] const FrameArenaStats& get_stats() const noexcept;
+
+private:
+  struct Overflow {
+    Overflow* next;
+    u64 size;
+    u64 offset;
+  };
+
+  u8* block = nullptr;
+  u64 offset = 0;
+  Overflow* overflows = nullptr; // Newest first
+  u32 generation = 1;
+  u64 next_capacity = 0; // Set by set_capacity, 0 keeps the current one
+  FrameArenaStats stats{.capacity = DEFAULT_CAPACITY};
+
+  [[nodiscard]] void* allocate_overflow(u64 bytes, u64 alignment) noexcept;
+  void free_overflows() noexcept;
+};
+
+// Growable array of trivially copyable values for per frame data. With an
+// arena the buffer is dropped by the first clear after a reset, and the next
+// push takes the previous capacity at once. Without one it uses the heap.
+template <typename T> class FrameVector {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  static constexpr i32 MIN_CAPACITY = 16;
+
+  FrameVector() noexcept = default;
+  explicit FrameVector(FrameArena* arena) noexcept : arena(arena) {}
+
+  FrameVector(FrameVector&& other) noexcept
+      : arena(other.arena), data(other.data), size(other.size),
+        capacity(other.capacity), generation(other.generation) {
+    other.data = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+  }
+
+  FrameVector& operator=(FrameVector&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    this->release();
+    this->arena = rhs.arena;
+    this->data = rhs.data;
+    this->size = rhs.size;
+    this->capacity = rhs.capacity;
+    this->generation = rhs.generation;
+    rhs.data = nullptr;
+    rhs.size = 0;
+    rhs.capacity = 0;
+
+    return *this;
+  }
+
+  FrameVector(const FrameVector&) = delete;
+  FrameVector& operator=(const FrameVector&) = delete;
+
+  ~FrameVector() noexcept {
+    this->release();
+  }
+
+  // Drops the values, call between frames
+  void set_arena(FrameArena* new_arena) noexcept {
+    this->release();
+    this->arena = new_arena;
+  }
+
+  /**
+   * Possible errors:
+   * - SDL_BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code reserve(i32 new_capacity) noexcept {
+    if (this->is_stale()) {
+      assert(this->size == 0 && "Frame vector used after reset, clear it");
+      this->data = nullptr;
+      this->size = 0;
+    }
+    if (this->data != nullptr && new_capacity <= this->capacity) {
+      return error_codes::OK;
+    }
+    if (this->data == nullptr) {
+      new_capacity = std::max(new_capacity, this->capacity);
+    }
+    new_capacity = std::max(new_capacity, MIN_CAPACITY);
+
+    T* new_data = nullptr;
+    if (this->arena != nullptr) {
+      new_data = (T*)this->arena->allocate(
+          sizeof(T) * new_capacity, alignof(T)
+      );
+      if (new_data == nullptr) {
+        return error_codes::SDL_BAD_ALLOCATION;
+      }
+      if (this->data != nullptr) {
+        std::memcpy(new_data, this->data, sizeof(T) * this->size);
+      }
+      this->generation = this->arena->get_generation();
+    } else {
+      new_data = (T*)std::realloc(this->data, sizeof(T) * new_capacity);
+      if (new_data == nullptr) {
+        return error_codes::SDL_BAD_ALLOCATION;
+      }
+    }
+
+    this->data = new_data;
+    this->capacity = new_capacity;
+    return error_codes::OK;
+  }
+
+  /**
+   * Possible errors:
+   * - SDL_BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code push(const T& value) noexcept {
+    if (this->data == nullptr || this->size == this->capacity ||
+        this->is_stale()) {
+      const error_code error = this->reserve(
+          this->size == this->capacity ? this->capacity * 2 : this->size + 1
+      );
+      if (error != error_codes::OK) {
+        return error;
+      }
+    }
+
+    this->data[this->size++] = value;
+    return error_codes::OK;
+  }
+
+  T pop() noexcept {
+    assert(this->size > 0);
+    return this->data[--this->size];
+  }
+
+  void clear() noexcept {
+    this->size = 0;
+    if (this->is_stale()) {
+      this->data = nullptr; // Keeps the capacity as a hint
+    }
+  }
+
+  [[nodiscard]] bool is_empty() const noexcept {
+    return this->size == 0;
+  }
+
+  [[nodiscard]] i32 get_size() const noexcept {
+    return this->size;
+  }
+
+  [[nodiscard]] i32 get_capacity() const noexcept {
+    return this->capacity;
+  }
+
+  [[nodiscard]] T* get_data() noexcept {
+    return this->data;
+  }
+
+  [[nodiscard]] const T* get_data() const noexcept {
+    return this->data;
+  }
+
+  [[nodiscard]] T& back() noexcept {
+    return this->data[this->size - 1];
+  }
+
+  [[nodiscard]] const T& back() const noexcept {
+    return this->data[this->size - 1];
+  }
+
+  [[nodiscard]] T& operator[](i32 index) noexcept {
+    return this->data[index];
+  }
+
+  [[nodiscard]] const T& operator[](i32 index) const noexcept {
+    return this->data[index];
+  }
+
+  [[nodiscard]] T* begin() noexcept {
+    return this->data;
+  }
+
+  [[nodiscard]] T* end() noexcept {
+    return this->data + this->size;
+  }
+
+  [[nodiscard]] const T* begin() const noexcept {
+    return this->data;
+  }
+
+  [[nodiscard]] const T* end() const noexcept {
+    return this->data + this->size;
+  }
+
+private:
+  FrameArena* arena = nullptr;
+  T* data = nullptr;
+  i32 size = 0;
+  i32 capacity = 0;
+  u32 generation = 0; // Of the arena when data was allocated
+
+  [[nodiscard]] bool is_stale() const noexcept {
+    return this->arena != nullptr && this->data != nullptr &&
+           this->generation != this->arena->get_generation();
+  }
+
+  void release() noexcept {
+    if (this->arena == nullptr) {
+      std::free(this->data);
+    }
+    this->data = nullptr;
+    this->size = 0;
+    this->capacity = 0;
+  }
+};
+
+} // namespace immpp
+
+#endif
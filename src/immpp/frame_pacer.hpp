@@ -0,0 +1,57 @@
+#ifndef IMMPP_FRAME_PACER_HPP
+#define IMMPP_FRAME_PACER_HPP
+
+#include "immpp/types.hpp"
+#include <array>
+
+namespace immpp {
+
+// All times are in nanoseconds
+struct FrameTimeStats {
+  u64 min = 0;
+  u64 avg = 0;
+  u64 p50 = 0;
+  u64 p99 = 0;
+  u64 max = 0;
+  i32 frames = 0; // Frames in the window the stats were computed over
+  u64 missed_deadlines = 0;
+};
+
+// Frame limiter on nanosecond ticks. Deadlines advance by exactly one
+// period so rounding errors do not accumulate, and the wait sleeps for most
+// of the remaining time then spins on the clock for the rest.
+class FramePacer {
+public:
+  static const i32 HISTORY_SIZE = 256;
+
+  // 0 disables the limiter
+  void set_fps(u32 fps) noexcept;
+  // Time before the deadline that is spun instead of slept
+  void set_spin_threshold(u64 ns) noexcept;
+
+  void begin_frame() noexcept;
+  // Records the frame time then waits until the frame deadline
+  void end_frame() noexcept;
+
+  // Stats of the work time (begin to end, without the wait) of the last
+  // HISTORY_SIZE frames
+  [[nodiscard]] FrameTimeStats get_stats() const noexcept;
+  [[nodiscard]] u64 get_frame_start() const noexcept;
+
+private:
+  u64 ns_per_frame = 1'000'000'000 / 60;
+  u64 spin_threshold = 1'000'000;
+  u64 frame_start = 0;
+  u64 deadline = 0;
+
+  std::array<u64, HISTORY_SIZE> history{};
+  i32 history_index = 0;
+  i32 history_size = 0;
+  u64 missed_deadlines = 0;
+
+  void wait_until(u64 time) const noexcept;
+};
+
+} // namespace immpp
+
+#endif
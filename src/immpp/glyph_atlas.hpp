@@ -0,0 +1,84 @@
+#ifndef IMMPP_GLYPH_ATLAS_HPP
+#define IMMPP_GLYPH_ATLAS_HPP
+
+#include "SDL3/SDL_render.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/draw_list.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct GlyphAtlasStats {
+  u64 hits = 0;
+  u64 misses = 0;
+  i32 count = 0;  // Glyphs currently in the atlas
+  i32 grows = 0;  // Times the atlas was full and doubled its texture
+  i32 resets = 0; // Times the atlas was full at its largest size
+  i32 texture_size = 0;
+};
+
+// Shared texture of rasterized glyphs keyed by (font, size, codepoint).
+// Strings are queued as textured quads colored per vertex, so no texture is
+// created after the glyphs were first seen. A full atlas doubles its texture
+// up to the renderer limit and only starts over once it can not grow.
+class GlyphAtlas {
+public:
+  static const i32 INITIAL_TEXTURE_SIZE = 512; // Pixels, power of 2
+  static const i32 MAX_TEXTURE_SIZE = 4096;    // Unless the renderer is lower
+
+  GlyphAtlas() noexcept = default;
+  GlyphAtlas(GlyphAtlas&& other) noexcept;
+  GlyphAtlas& operator=(GlyphAtlas&& rhs) noexcept;
+
+  GlyphAtlas(const GlyphAtlas&) = delete;
+  GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+  ~GlyphAtlas() noexcept;
+
+  // Queues the text with its top left corner at position, the renderer is
+  // used to upload new glyphs
+  void draw(
+      SDL_Renderer* renderer, DrawList& draws, TTF_Font* font, const c8* text,
+      i32 text_length, vec2<f32> position, rgba8 color
+  ) noexcept;
+
+  // Drops every glyph and the atlas texture
+  void clear() noexcept;
+
+  [[nodiscard]] const GlyphAtlasStats& get_stats() const noexcept;
+
+private:
+  struct Glyph {
+    u64 key;
+    SDL_FRect source;
+    f32 advance;
+  };
+
+  SDL_Texture* texture = nullptr;
+  i32 texture_size = INITIAL_TEXTURE_SIZE;
+  i32 max_texture_size = 0; // Of the renderer, queried with the texture
+
+  // Shelf packing cursor
+  vec2<i32> cursor{};
+  i32 shelf_height = 0;
+
+  // Open addressing table, key 0 is an empty slot
+  Glyph* glyphs = nullptr;
+  i32 capacity = 0;
+
+  GlyphAtlasStats stats{};
+
+  [[nodiscard]] const Glyph* get_glyph(
+      SDL_Renderer* renderer, DrawList& draws, TTF_Font* font, u32 codepoint
+  ) noexcept;
+  [[nodiscard]] Glyph* find_slot(u64 key) noexcept;
+  [[nodiscard]] bool grow_table() noexcept;
+  [[nodiscard]] bool create_texture(SDL_Renderer* renderer) noexcept;
+  // Doubles the texture and drops the glyphs, false at the largest size
+  [[nodiscard]] bool grow_texture(SDL_Renderer* renderer) noexcept;
+  void reset() noexcept;
+};
+
+} // namespace immpp
+
+#endif
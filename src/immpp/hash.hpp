@@ -0,0 +1,60 @@
+#ifndef IMMPP_HASH_HPP
+#define IMMPP_HASH_HPP
+
+#include "immpp/types.hpp"
+
+namespace immpp::hash {
+
+const u64 FNV_OFFSET = 0xcbf2'9ce4'8422'2325;
+const u64 FNV_PRIME = 0x0000'0100'0000'01b3;
+
+// FNV-1a over a null terminated string
+[[nodiscard]] inline u64
+string(const c8* text, u64 seed = FNV_OFFSET) noexcept {
+  u64 hash = seed;
+  for (; *text != '\0'; ++text) {
+    hash ^= (u8)*text;
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// FNV-1a over a null terminated string, also outputs its length
+[[nodiscard]] inline u64
+string(const c8* text, i32& length, u64 seed = FNV_OFFSET) noexcept {
+  u64 hash = seed;
+  const c8* start = text;
+  for (; *text != '\0'; ++text) {
+    hash ^= (u8)*text;
+    hash *= FNV_PRIME;
+  }
+  length = (i32)(text - start);
+  return hash;
+}
+
+// FNV-1a over a byte range
+[[nodiscard]] inline u64
+bytes(const void* data, u64 length, u64 seed = FNV_OFFSET) noexcept {
+  const auto* bytes = (const u8*)data;
+  u64 hash = seed;
+  for (u64 i = 0; i < length; ++i) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// FNV-1a style over 32 bit words, a quarter of the multiplies of bytes
+[[nodiscard]] inline u64
+words(const u32* data, u64 count, u64 seed = FNV_OFFSET) noexcept {
+  u64 hash = seed;
+  for (u64 i = 0; i < count; ++i) {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+} // namespace immpp::hash
+
+#endif
@@ -15,6 +15,8 @@ public:
 
   // NOLINTNEXTLINE
   [[nodiscard]] opt_error init() noexcept;
+  // Uses the offscreen/dummy video driver, no display is needed
+  [[nodiscard]] opt_error init_headless() noexcept;
   ~Initializer() noexcept;
 
 private:
@@ -0,0 +1,179 @@
+#include "./layout.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace immpp {
+
+error_code layout::push_row(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* widths, i32 widths_size, u8 alignments
+) noexcept {
+  i32 width = 0;
+  i32 parts = 0;
+  f32 remaining_width = area.w;
+  f32 full_width = area.w;
+  for (i32 i = 0; i < widths_size; ++i) {
+    width = widths[i];
+    if (size::is_grow(width)) {
+      parts += size::decode_grow(width);
+    } else {
+      remaining_width -= size::decode_fixed(width);
+    }
+  }
+
+  remaining_width = std::max(remaining_width, 0.0F);
+  if (parts > 0) {
+    remaining_width /= parts;
+  } else {
+    switch (alignments & Alignment::HORIZONTAL_MASK) {
+    case Alignment::HORIZONTAL_LEFT:
+      full_width -= remaining_width;
+      break;
+
+    case Alignment::HORIZONTAL_CENTER:
+      full_width = (remaining_width / 2.0F) + (area.w - remaining_width);
+      break;
+
+    default: // Alignment::HORIZONTAL_RIGHT:
+      break;
+    }
+  }
+
+  rect<f32> new_rect{.y = area.y, .h = area.h};
+  for (i32 i = widths_size - 1; i > -1; --i) {
+    width = widths[i];
+    if (size::is_grow(width)) {
+      new_rect.w = remaining_width * size::decode_grow(width);
+    } else {
+      new_rect.w = size::decode_fixed(width);
+    }
+
+    full_width -= new_rect.w;
+    new_rect.x = area.x + full_width;
+    if (widget_sizes.push(new_rect) != error_codes::OK) {
+      return error_codes::SDL_BAD_ALLOCATION;
+    }
+  }
+
+  return error_codes::OK;
+}
+
+error_code layout::push_column(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* heights, i32 heights_size, u8 alignments
+) noexcept {
+  i32 height = 0;
+  i32 parts = 0;
+  f32 remaining_height = area.h;
+  f32 full_height = area.h;
+
+  for (i32 i = 0; i < heights_size; ++i) {
+    height = heights[i];
+    if (size::is_grow(height)) {
+      parts += size::decode_grow(height);
+    } else {
+      remaining_height -= size::decode_fixed(height);
+    }
+  }
+
+  remaining_height = std::max(remaining_height, 0.0F);
+
+  if (parts > 0) {
+    remaining_height /= parts;
+  } else {
+    switch (alignments & Alignment::VERTICAL_MASK) {
+    case Alignment::VERTICAL_TOP:
+      full_height -= remaining_height;
+      break;
+
+    case Alignment::VERTICAL_CENTER:
+      full_height = (remaining_height / 2.0F) + (area.h - remaining_height);
+      break;
+
+    default: // Alignment::VERTICAL_BOTTOM:
+      break;
+    }
+  }
+
+  rect<f32> new_rect{.x = area.x, .w = area.w};
+  for (i32 i = heights_size - 1; i > -1; --i) {
+    height = heights[i];
+    if (size::is_grow(height)) {
+      new_rect.h = remaining_height * size::decode_grow(height);
+    } else {
+      new_rect.h = size::decode_fixed(height);
+    }
+
+    full_height -= new_rect.h;
+    new_rect.y = area.y + full_height;
+    if (widget_sizes.push(new_rect) != error_codes::OK) {
+      return error_codes::SDL_BAD_ALLOCATION;
+    }
+  }
+
+  return error_codes::OK;
+}
+
+void layout::normalize_rectangle(
+    rect<f32>& rectangle, const rect<f32>& limits
+) noexcept {
+  rectangle.x = std::trunc(rectangle.x);
+  rectangle.y = std::trunc(rectangle.y);
+  if (size::is_type(rectangle.w)) {
+    rectangle.w = limits.w - std::max(0.0F, rectangle.x - limits.x);
+  }
+  if (size::is_type(rectangle.h)) {
+    rectangle.h = limits.h - std::max(0.0F, rectangle.y - limits.y);
+  }
+}
+
+// TODO: can add alignment logic here
+rect<f32> layout::calculate_text_rectangle(
+    rect<f32> area, vec2<f32> fit_size, vec2<f32> max_size
+) noexcept {
+  rect<f32> output{.size = fit_size};
+
+  f32 tmp = 0.0F;
+  if (size::is_type(area.w)) {
+    tmp = size::is_fit(area.w) ? fit_size.x : max_size.x;
+  } else {
+    tmp = area.w;
+  }
+  // std::trunc to avoid blurry text
+  output.x = std::trunc(area.x + ((tmp - fit_size.x) / 2.0F));
+
+  if (size::is_type(area.h)) {
+    tmp = size::is_fit(area.h) ? fit_size.y : max_size.y;
+  } else {
+    tmp = area.h;
+  }
+  // std::trunc to avoid blurry text
+  output.y = std::trunc(area.y + ((tmp - fit_size.y) / 2.0F));
+
+  return output;
+}
+
+f64 layout::clamp_scroll(f64 offset, f64 content, f32 viewport) noexcept {
+  return std::max(0.0, std::min(offset, content - viewport));
+}
+
+ScrollRange layout::calculate_scroll_range(
+    f64 offset, f32 viewport, f32 item_extent, i32 item_count
+) noexcept {
+  if (item_extent <= 0.0F || item_count <= 0) {
+    return {};
+  }
+
+  // f64 keeps the indices exact for millions of items
+  const f64 first = std::floor(offset / item_extent);
+  const f64 last = std::ceil((offset + viewport) / item_extent);
+  const i32 clamped_first = (i32)std::clamp(first, 0.0, (f64)item_count);
+  const i32 clamped_last =
+      (i32)std::clamp(last, (f64)clamped_first, (f64)item_count);
+
+  return {.first = clamped_first, .count = clamped_last - clamped_first};
+}
+
+} // namespace immpp
@@ -0,0 +1,186 @@
+#ifndef IMMPP_LAYOUT_HPP
+#define IMMPP_LAYOUT_HPP
+
+#include "immpp/frame_arena.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+
+namespace immpp {
+
+enum Alignment : u8 {
+  // Horizontal
+  HORIZONTAL_LEFT = 0x00,
+  HORIZONTAL_CENTER = 0x01,
+  HORIZONTAL_RIGHT = 0x02,
+  HORIZONTAL_MASK = 0x03,
+
+  // Vertical
+  VERTICAL_TOP = 0x00,
+  VERTICAL_CENTER = 0x10,
+  VERTICAL_BOTTOM = 0x20,
+  VERTICAL_MASK = 0x30,
+};
+
+// Items [first, first + count) of a scrolled list
+struct ScrollRange {
+  i32 first = 0;
+  i32 count = 0;
+};
+
+namespace layout {
+
+/**
+ * Splits the area into children with the encoded widths/heights and pushes
+ * them in reverse, so the first child is at the back of widget_sizes.
+ * Alignment is only used when there are no grow children.
+ *
+ * Possible errors:
+ * - SDL_BAD_ALLOCATION
+ **/
+[[nodiscard]] error_code push_row(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* widths, i32 widths_size, u8 alignments
+) noexcept;
+[[nodiscard]] error_code push_column(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* heights, i32 heights_size, u8 alignments
+) noexcept;
+
+// === Static Layouts === //
+
+// Totals of an encoded spec pack computed at compile time. A child of index
+// i is part * GROWS[i] + FIXEDS[i] long and ends part * GROW_SUFFIXES[i] +
+// FIXED_SUFFIXES[i] before the end of the layout.
+template <i32... Specs> struct StaticSpecs {
+  static constexpr i32 COUNT = sizeof...(Specs);
+  static constexpr i32 FIXED =
+      (0 + ... + (size::is_grow(Specs) ? 0 : size::decode_fixed(Specs)));
+  static constexpr i32 PARTS =
+      (0 + ... + (size::is_grow(Specs) ? size::decode_grow(Specs) : 0));
+
+  static constexpr std::array<f32, COUNT> GROWS{
+    (f32)(size::is_grow(Specs) ? size::decode_grow(Specs) : 0)...
+  };
+  static constexpr std::array<f32, COUNT> FIXEDS{
+    (f32)(size::is_grow(Specs) ? 0 : size::decode_fixed(Specs))...
+  };
+
+  [[nodiscard]] static constexpr std::array<f32, COUNT>
+  suffix_sums(const std::array<f32, COUNT>& values) noexcept {
+    std::array<f32, COUNT> sums{};
+    f32 sum = 0.0F;
+    for (i32 i = COUNT - 1; i > -1; --i) {
+      sum += values[i];
+      sums[i] = sum;
+    }
+    return sums;
+  }
+
+  static constexpr std::array<f32, COUNT> GROW_SUFFIXES = suffix_sums(GROWS);
+  static constexpr std::array<f32, COUNT> FIXED_SUFFIXES = suffix_sums(FIXEDS);
+};
+
+template <bool ROW, i32... Specs>
+[[nodiscard]] error_code push_static(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area, u8 alignments
+) noexcept {
+  using Static = StaticSpecs<Specs...>;
+  if (widget_sizes.reserve(widget_sizes.get_size() + Static::COUNT) !=
+      error_codes::OK) {
+    return error_codes::SDL_BAD_ALLOCATION;
+  }
+
+  const f32 start = ROW ? area.x : area.y;
+  const f32 length = ROW ? area.w : area.h;
+  const f32 remaining = std::max(length - (f32)Static::FIXED, 0.0F);
+  f32 part = 0.0F;
+  f32 end = length;
+  if constexpr (Static::PARTS > 0) {
+    part = remaining / (f32)Static::PARTS;
+  } else {
+    // Same values as the dynamic layouts, vertical shifted onto horizontal
+    const u8 alignment = ROW ? alignments & Alignment::HORIZONTAL_MASK
+                             : (alignments & Alignment::VERTICAL_MASK) >> 4;
+    switch (alignment) {
+    case Alignment::HORIZONTAL_LEFT:
+      end -= remaining;
+      break;
+
+    case Alignment::HORIZONTAL_CENTER:
+      end = (remaining / 2.0F) + (length - remaining);
+      break;
+
+    default: // Alignment::HORIZONTAL_RIGHT:
+      break;
+    }
+  }
+
+  // Children are independent of each other, no running offset
+  rect<f32> new_rect = area;
+  for (i32 i = Static::COUNT - 1; i > -1; --i) {
+    const f32 child = (part * Static::GROWS[i]) + Static::FIXEDS[i];
+    const f32 offset =
+        end - ((part * Static::GROW_SUFFIXES[i]) + Static::FIXED_SUFFIXES[i]);
+    if constexpr (ROW) {
+      new_rect.x = start + offset;
+      new_rect.w = child;
+    } else {
+      new_rect.y = start + offset;
+      new_rect.h = child;
+    }
+    static_cast<void>(widget_sizes.push(new_rect));
+  }
+
+  return error_codes::OK;
+}
+
+/**
+ * Same as push_row/push_column with the specs as template arguments, e.g.
+ * push_row<size::encode_fixed(64), size::encode_grow(1)>(...).
+ *
+ * Possible errors:
+ * - SDL_BAD_ALLOCATION
+ **/
+template <i32... Widths>
+[[nodiscard]] error_code push_row(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area, u8 alignments
+) noexcept {
+  return push_static<true, Widths...>(widget_sizes, area, alignments);
+}
+
+template <i32... Heights>
+[[nodiscard]] error_code push_column(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area, u8 alignments
+) noexcept {
+  return push_static<false, Heights...>(widget_sizes, area, alignments);
+}
+
+// === Rectangles === //
+
+// Truncates the position and resolves fit/grow sizes against the limits
+void normalize_rectangle(
+    rect<f32>& rectangle, const rect<f32>& limits
+) noexcept;
+
+// Centers text of fit_size in the area
+[[nodiscard]] rect<f32> calculate_text_rectangle(
+    rect<f32> area, vec2<f32> fit_size, vec2<f32> max_size
+) noexcept;
+
+// === Scrolling === //
+
+// Keeps the offset between 0 and the content past the viewport
+[[nodiscard]] f64 clamp_scroll(f64 offset, f64 content, f32 viewport) noexcept;
+
+// Items of item_extent overlapping the viewport scrolled by offset
+[[nodiscard]] ScrollRange calculate_scroll_range(
+    f64 offset, f32 viewport, f32 item_extent, i32 item_count
+) noexcept;
+
+} // namespace layout
+
+} // namespace immpp
+
+#endif
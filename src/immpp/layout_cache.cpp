@@ -0,0 +1,228 @@
+#include "./layout_cache.hpp"
+#include "immpp/hash.hpp"
+#include "immpp/layout.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const immpp::i32 MIN_RECTANGLES = 1024; // Power of 2
+
+} // namespace
+
+namespace immpp {
+
+LayoutCache::LayoutCache(LayoutCache&& other) noexcept
+    : entries(std::move(other.entries)), rectangles(other.rectangles),
+      spare(other.spare), rectangle_size(other.rectangle_size),
+      rectangle_capacity(other.rectangle_capacity), stats(other.stats) {
+  other.rectangles = nullptr;
+  other.spare = nullptr;
+  other.rectangle_size = 0;
+  other.rectangle_capacity = 0;
+}
+
+LayoutCache& LayoutCache::operator=(LayoutCache&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  std::free(this->rectangles);
+  std::free(this->spare);
+  this->entries = std::move(rhs.entries);
+  this->rectangles = rhs.rectangles;
+  this->spare = rhs.spare;
+  this->rectangle_size = rhs.rectangle_size;
+  this->rectangle_capacity = rhs.rectangle_capacity;
+  this->stats = rhs.stats;
+  rhs.rectangles = nullptr;
+  rhs.spare = nullptr;
+  rhs.rectangle_size = 0;
+  rhs.rectangle_capacity = 0;
+
+  return *this;
+}
+
+LayoutCache::~LayoutCache() noexcept {
+  std::free(this->rectangles);
+  std::free(this->spare);
+  this->rectangles = nullptr;
+  this->spare = nullptr;
+}
+
+error_code LayoutCache::push_row(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* widths, i32 widths_size, u8 alignments
+) noexcept {
+  return this->push(
+      true, widget_sizes, area, widths, widths_size, alignments
+  );
+}
+
+error_code LayoutCache::push_column(
+    FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* heights, i32 heights_size, u8 alignments
+) noexcept {
+  return this->push(
+      false, widget_sizes, area, heights, heights_size, alignments
+  );
+}
+
+void LayoutCache::next_frame() noexcept {
+  this->entries.next_frame();
+}
+
+void LayoutCache::clear() noexcept {
+  this->entries.clear();
+  this->rectangle_size = 0;
+  this->update_stats();
+}
+
+const LayoutCacheStats& LayoutCache::get_stats() const noexcept {
+  return this->stats;
+}
+
+// === Private === //
+
+error_code LayoutCache::push(
+    bool row, FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+    const i32* specs, i32 specs_size, u8 alignments
+) noexcept {
+  const std::array<u32, 2> header{
+    (u32)row | ((u32)alignments << 8), (u32)specs_size
+  };
+  u64 key = hash::words(header.data(), header.size());
+  key = hash::words((const u32*)&area, sizeof(area) / sizeof(u32), key);
+  key = hash::words((const u32*)specs, specs_size, key);
+  // Low bits of the word hash only see the low bits of the input, the slot
+  // table probes from the low bits
+  key ^= key >> 32;
+
+  const Entry* cached = this->entries.find(key);
+  if (cached != nullptr) {
+    ++this->stats.hits;
+    if (widget_sizes.reserve(widget_sizes.get_size() + cached->count) !=
+        error_codes::OK) {
+      return error_codes::SDL_BAD_ALLOCATION;
+    }
+    const rect<f32>* stored = this->rectangles + cached->first;
+    for (i32 i = 0; i < cached->count; ++i) {
+      static_cast<void>(widget_sizes.push(stored[i]));
+    }
+    return error_codes::OK;
+  }
+  ++this->stats.misses;
+
+  const i32 first_size = widget_sizes.get_size();
+  const error_code error =
+      row ? layout::push_row(widget_sizes, area, specs, specs_size, alignments)
+          : layout::push_column(
+                widget_sizes, area, specs, specs_size, alignments
+            );
+  if (error != error_codes::OK) {
+    return error;
+  }
+
+  // Not cached when it does not fit, the layout itself is fine. Before the
+  // insert, it can evict and move the rectangles
+  const i32 count = widget_sizes.get_size() - first_size;
+  if (count > MAX_RECTANGLES || !this->reserve_rectangles(count)) {
+    return error_codes::OK;
+  }
+
+  Entry* entry = this->entries.insert(key);
+  this->update_stats();
+  if (entry == nullptr) {
+    return error_codes::OK;
+  }
+
+  entry->first = this->rectangle_size;
+  entry->count = count;
+  for (i32 i = 0; i < count; ++i) {
+    this->rectangles[this->rectangle_size++] = widget_sizes[first_size + i];
+  }
+  return error_codes::OK;
+}
+
+bool LayoutCache::reserve_rectangles(i32 count) noexcept {
+  if (this->rectangle_size + count <= this->rectangle_capacity) {
+    return true;
+  }
+
+  // Rectangles of evicted entries are reclaimed by compact
+  static_cast<void>(this->entries.evict());
+  i32 used = 0;
+  const Entry* slots = this->entries.get_entries();
+  for (i32 i = 0; slots != nullptr && i < this->entries.get_capacity(); ++i) {
+    if (slots[i].key != 0) {
+      used += slots[i].count;
+    }
+  }
+  if (used + count > MAX_RECTANGLES) {
+    this->compact();
+    return this->rectangle_size + count <= this->rectangle_capacity;
+  }
+
+  i32 capacity = std::max(this->rectangle_capacity, MIN_RECTANGLES);
+  while (used + count > capacity) {
+    capacity *= 2;
+  }
+  if (capacity != this->rectangle_capacity) {
+    auto* grown = (rect<f32>*)std::malloc(sizeof(rect<f32>) * capacity);
+    auto* grown_spare = (rect<f32>*)std::malloc(sizeof(rect<f32>) * capacity);
+    if (grown == nullptr || grown_spare == nullptr) {
+      std::free(grown);
+      std::free(grown_spare);
+      IMMPP_LOG_WARN("Bad Allocation on layout cache rectangles");
+      return false;
+    }
+
+    // Compacts into the grown buffer, then drops the old one
+    std::free(this->spare);
+    this->spare = grown;
+    this->compact();
+    std::free(this->spare);
+    this->spare = grown_spare;
+    this->rectangle_capacity = capacity;
+    this->update_stats();
+    return true;
+  }
+
+  this->compact();
+  return true;
+}
+
+void LayoutCache::compact() noexcept {
+  Entry* slots = this->entries.get_entries();
+  i32 size = 0;
+  for (i32 i = 0; slots != nullptr && i < this->entries.get_capacity(); ++i) {
+    Entry& entry = slots[i];
+    if (entry.key == 0) {
+      continue;
+    }
+
+    std::memcpy(
+        this->spare + size, this->rectangles + entry.first,
+        sizeof(rect<f32>) * entry.count
+    );
+    entry.first = size;
+    size += entry.count;
+  }
+
+  std::swap(this->rectangles, this->spare);
+  this->rectangle_size = size;
+}
+
+void LayoutCache::update_stats() noexcept {
+  this->stats.evictions = this->entries.get_evictions();
+  this->stats.grows = this->entries.get_grows();
+  this->stats.count = this->entries.get_count();
+  this->stats.capacity = this->entries.get_capacity();
+  this->stats.rectangle_capacity = this->rectangle_capacity;
+}
+
+} // namespace immpp
@@ -0,0 +1,98 @@
+#ifndef IMMPP_LAYOUT_CACHE_HPP
+#define IMMPP_LAYOUT_CACHE_HPP
+
+#include "immpp/frame_arena.hpp"
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct LayoutCacheStats {
+  u64 hits = 0;
+  u64 misses = 0;
+  u64 evictions = 0;
+  u64 grows = 0;
+  i32 count = 0;
+  i32 capacity = 0;
+  i32 rectangle_capacity = 0;
+
+  [[nodiscard]] f32 get_hit_rate() const noexcept {
+    const u64 total = this->hits + this->misses;
+    return total == 0 ? 0.0F : (f32)this->hits / (f32)total;
+  }
+};
+
+// Memoized layout::push_row/push_column results keyed by the spec array
+// contents, the parent rectangle and the alignments. A hit replays the
+// stored rectangles. Layouts not used in the current or previous frame are
+// evicted in place, so scrolled or resized areas do not flush the rest, and
+// their rectangles are reclaimed by compacting the side buffer.
+class LayoutCache {
+public:
+  static const i32 DEFAULT_CAPACITY = 1024; // Layouts, power of 2
+  static const i32 MAX_RECTANGLES = 1 << 16; // Larger layouts are not cached
+
+  LayoutCache() noexcept = default;
+  LayoutCache(LayoutCache&& other) noexcept;
+  LayoutCache& operator=(LayoutCache&& rhs) noexcept;
+
+  LayoutCache(const LayoutCache&) = delete;
+  LayoutCache& operator=(const LayoutCache&) = delete;
+
+  ~LayoutCache() noexcept;
+
+  /**
+   * Same as layout::push_row/push_column.
+   *
+   * Possible errors:
+   * - SDL_BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code push_row(
+      FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+      const i32* widths, i32 widths_size, u8 alignments
+  ) noexcept;
+  [[nodiscard]] error_code push_column(
+      FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+      const i32* heights, i32 heights_size, u8 alignments
+  ) noexcept;
+
+  // Advances the generation used for eviction, call once per frame
+  void next_frame() noexcept;
+  // Drops every layout, e.g. on window resize
+  void clear() noexcept;
+
+  [[nodiscard]] const LayoutCacheStats& get_stats() const noexcept;
+
+private:
+  struct Entry {
+    u64 key; // 0 marks an empty slot
+    u32 generation;
+    i32 first; // Into rectangles
+    i32 count;
+  };
+
+  SlotTable<Entry> entries{DEFAULT_CAPACITY};
+
+  // Rectangles of the entries and the target of compact, both of
+  // rectangle_capacity
+  rect<f32>* rectangles = nullptr;
+  rect<f32>* spare = nullptr;
+  i32 rectangle_size = 0;
+  i32 rectangle_capacity = 0;
+
+  LayoutCacheStats stats{.capacity = DEFAULT_CAPACITY};
+
+  [[nodiscard]] error_code push(
+      bool row, FrameVector<rect<f32>>& widget_sizes, const rect<f32>& area,
+      const i32* specs, i32 specs_size, u8 alignments
+  ) noexcept;
+  // Makes room for count rectangles, false if it could not grow
+  [[nodiscard]] bool reserve_rectangles(i32 count) noexcept;
+  // Copies the rectangles of the entries into spare and swaps the buffers
+  void compact() noexcept;
+  void update_stats() noexcept;
+};
+
+} // namespace immpp
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef IMMPP_LOGGER_HPP
 #define IMMPP_LOGGER_HPP
 
+#include "immpp/binary_log.hpp"
 #include "immpp/types.hpp"
 
 namespace immpp {
@@ -16,7 +17,25 @@ enum LogLevel : u8 {
 
 namespace logger {
 
+const i32 QUEUE_CAPACITY = 1024; // Power of 2
+const i32 MESSAGE_SIZE = 256;    // Longer queued messages are truncated
+
 void set_level(LogLevel new_level) noexcept;
+[[nodiscard]] LogLevel get_level() noexcept;
+
+/**
+ * Writes the messages from a background thread, callers only format the
+ * message into a bounded lock-free queue. Messages are dropped while the
+ * queue is full, fatal flushes the queue before returning.
+ *
+ * NOTE: Toggle it while no other thread is logging
+ **/
+void set_async(bool enabled) noexcept;
+// Blocks until the queued messages are written
+void flush() noexcept;
+// Messages dropped because the queue was full
+[[nodiscard]] u64 get_dropped() noexcept;
+
 void fatal(const c8* message, ...) noexcept;
 void error(const c8* message, ...) noexcept;
 void warn(const c8* message, ...) noexcept;
@@ -27,4 +46,41 @@ void debug(const c8* message, ...) noexcept;
 
 } // namespace immpp
 
+// Levels above IMMPP_LOG_LEVEL are compiled out with their arguments, the
+// enabled ones check the runtime level before evaluating the arguments.
+// While immpp/binary_log.hpp is open the messages are stored unformatted.
+#ifndef IMMPP_LOG_LEVEL
+#define IMMPP_LOG_LEVEL 5 // DEBUG
+#endif
+
+// NOLINTNEXTLINE
+#define IMMPP_LOG(message_level, function, ...)                                \
+  do {                                                                         \
+    if constexpr (IMMPP_LOG_LEVEL >= (message_level)) {                        \
+      if (immpp::logger::get_level() >= (message_level)) {                     \
+        if (immpp::binary_log::is_open()) {                                    \
+          immpp::binary_log::write((message_level), __VA_ARGS__);              \
+        } else {                                                               \
+          immpp::logger::function(__VA_ARGS__);                                \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
+
+// NOLINTNEXTLINE
+#define IMMPP_LOG_FATAL(...)                                                   \
+  IMMPP_LOG(immpp::LogLevel::FATAL, fatal, __VA_ARGS__)
+// NOLINTNEXTLINE
+#define IMMPP_LOG_ERROR(...)                                                   \
+  IMMPP_LOG(immpp::LogLevel::ERROR, error, __VA_ARGS__)
+// NOLINTNEXTLINE
+#define IMMPP_LOG_WARN(...)                                                    \
+  IMMPP_LOG(immpp::LogLevel::WARN, warn, __VA_ARGS__)
+// NOLINTNEXTLINE
+#define IMMPP_LOG_INFO(...)                                                    \
+  IMMPP_LOG(immpp::LogLevel::INFO, info, __VA_ARGS__)
+// NOLINTNEXTLINE
+#define IMMPP_LOG_DEBUG(...)                                                   \
+  IMMPP_LOG(immpp::LogLevel::DEBUG, debug, __VA_ARGS__)
+
 #endif
@@ -0,0 +1,55 @@
+#include "./malloc_interposer.hpp"
+#include "immpp/allocations.hpp"
+#include "immpp/types.hpp"
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+std::atomic<immpp::u64> calls{0}; // NOLINT
+
+} // namespace
+
+#ifdef __GLIBC__
+// Counts the calls from immpp, ds and SDL alike
+extern "C" {
+
+void* __libc_malloc(size_t size);                 // NOLINT
+void* __libc_calloc(size_t count, size_t size);   // NOLINT
+void* __libc_realloc(void* pointer, size_t size); // NOLINT
+
+void* malloc(size_t size) noexcept { // NOLINT
+  calls.fetch_add(1, std::memory_order_relaxed);
+  immpp::allocations::record(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept { // NOLINT
+  calls.fetch_add(1, std::memory_order_relaxed);
+  immpp::allocations::record(count * size);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept { // NOLINT
+  calls.fetch_add(1, std::memory_order_relaxed);
+  immpp::allocations::record(size);
+  return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+namespace immpp {
+
+bool malloc_interposer::is_enabled() noexcept {
+#ifdef __GLIBC__
+  return true;
+#else
+  return false;
+#endif
+}
+
+u64 malloc_interposer::get_calls() noexcept {
+  return calls.load(std::memory_order_relaxed);
+}
+
+} // namespace immpp
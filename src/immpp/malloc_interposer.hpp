@@ -0,0 +1,19 @@
+#ifndef IMMPP_MALLOC_INTERPOSER_HPP
+#define IMMPP_MALLOC_INTERPOSER_HPP
+
+#include "immpp/types.hpp"
+
+namespace immpp::malloc_interposer {
+
+/**
+ * Linking malloc_interposer.cpp replaces malloc, calloc and realloc with
+ * glibc, every call is counted and passed to allocations::record. Only for
+ * the tests and the bench, it is not part of the library.
+ **/
+[[nodiscard]] bool is_enabled() noexcept;
+// Calls since the start of the program
+[[nodiscard]] u64 get_calls() noexcept;
+
+} // namespace immpp::malloc_interposer
+
+#endif
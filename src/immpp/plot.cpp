@@ -0,0 +1,330 @@
+#include "./plot.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+using immpp::f32;
+using immpp::i32;
+using immpp::PlotRange;
+
+inline void merge(PlotRange& output, const PlotRange& other) noexcept {
+  output.min = std::min(output.min, other.min);
+  output.max = std::max(output.max, other.max);
+}
+
+// Lanes of the vector accumulators stored by the SIMD paths
+template <std::size_t LANES>
+[[nodiscard]] inline PlotRange reduce(
+    const std::array<f32, LANES>& lows, const std::array<f32, LANES>& highs
+) noexcept {
+  PlotRange output{lows[0], highs[0]};
+  for (std::size_t i = 1; i < LANES; ++i) {
+    output.min = std::min(output.min, lows[i]);
+    output.max = std::max(output.max, highs[i]);
+  }
+  return output;
+}
+
+// Range of the values of a column, at least one value
+inline void get_column(
+    i32 column, i32 count, i32 column_count, i32& start, i32& end
+) noexcept {
+  start = (i32)((immpp::i64)column * count / column_count);
+  end = (i32)((immpp::i64)(column + 1) * count / column_count);
+  if (end <= start) {
+    start = std::min(start, count - 1);
+    end = start + 1;
+  }
+}
+
+} // namespace
+
+namespace immpp {
+
+// === Decimation === //
+
+PlotRange plot::min_max(const f32* values, i32 count) noexcept {
+  assert(count > 0);
+  PlotRange output{values[0], values[0]};
+  i32 i = 0;
+
+#if defined(__AVX__)
+  if (count >= 8) {
+    __m256 low = _mm256_loadu_ps(values);
+    __m256 high = low;
+    for (i = 8; i + 8 <= count; i += 8) {
+      const __m256 value = _mm256_loadu_ps(values + i);
+      low = _mm256_min_ps(low, value);
+      high = _mm256_max_ps(high, value);
+    }
+
+    std::array<f32, 8> lows{};
+    std::array<f32, 8> highs{};
+    _mm256_storeu_ps(lows.data(), low);
+    _mm256_storeu_ps(highs.data(), high);
+    output = reduce(lows, highs);
+  }
+#elif defined(__SSE__) || defined(_M_X64)
+  if (count >= 4) {
+    __m128 low = _mm_loadu_ps(values);
+    __m128 high = low;
+    for (i = 4; i + 4 <= count; i += 4) {
+      const __m128 value = _mm_loadu_ps(values + i);
+      low = _mm_min_ps(low, value);
+      high = _mm_max_ps(high, value);
+    }
+
+    std::array<f32, 4> lows{};
+    std::array<f32, 4> highs{};
+    _mm_storeu_ps(lows.data(), low);
+    _mm_storeu_ps(highs.data(), high);
+    output = reduce(lows, highs);
+  }
+#elif defined(__ARM_NEON)
+  if (count >= 4) {
+    float32x4_t low = vld1q_f32(values);
+    float32x4_t high = low;
+    for (i = 4; i + 4 <= count; i += 4) {
+      const float32x4_t value = vld1q_f32(values + i);
+      low = vminq_f32(low, value);
+      high = vmaxq_f32(high, value);
+    }
+
+    std::array<f32, 4> lows{};
+    std::array<f32, 4> highs{};
+    vst1q_f32(lows.data(), low);
+    vst1q_f32(highs.data(), high);
+    output = reduce(lows, highs);
+  }
+#endif
+
+  // Tail of the vector paths, everything for the scalar one
+  for (; i < count; ++i) {
+    output.min = std::min(output.min, values[i]);
+    output.max = std::max(output.max, values[i]);
+  }
+  return output;
+}
+
+void plot::decimate(
+    const f32* values, i32 count, PlotRange* columns, i32 column_count
+) noexcept {
+  if (count <= 0) {
+    std::fill(columns, columns + column_count, PlotRange{});
+    return;
+  }
+
+  i32 start = 0;
+  i32 end = 0;
+  for (i32 column = 0; column < column_count; ++column) {
+    get_column(column, count, column_count, start, end);
+    columns[column] = min_max(values + start, end - start);
+  }
+}
+
+// === Series === //
+
+PlotSeries::PlotSeries(PlotSeries&& other) noexcept
+    : samples(other.samples), blocks(other.blocks), capacity(other.capacity),
+      size(other.size), head(other.head) {
+  other.samples = nullptr;
+  other.blocks = nullptr;
+  other.capacity = 0;
+  other.size = 0;
+  other.head = 0;
+}
+
+PlotSeries& PlotSeries::operator=(PlotSeries&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  std::free(this->samples);
+  std::free(this->blocks);
+  this->samples = rhs.samples;
+  this->blocks = rhs.blocks;
+  this->capacity = rhs.capacity;
+  this->size = rhs.size;
+  this->head = rhs.head;
+  rhs.samples = nullptr;
+  rhs.blocks = nullptr;
+  rhs.capacity = 0;
+  rhs.size = 0;
+  rhs.head = 0;
+
+  return *this;
+}
+
+PlotSeries::~PlotSeries() noexcept {
+  std::free(this->samples);
+  std::free(this->blocks);
+  this->samples = nullptr;
+  this->blocks = nullptr;
+}
+
+error_code PlotSeries::set_capacity(i32 capacity) noexcept {
+  std::free(this->samples);
+  std::free(this->blocks);
+  this->samples = nullptr;
+  this->blocks = nullptr;
+  this->capacity = 0;
+  this->clear();
+  if (capacity <= 0) {
+    return error_codes::OK;
+  }
+
+  const i32 rounded = (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+  this->samples = (f32*)std::malloc(sizeof(f32) * rounded);
+  this->blocks =
+      (PlotRange*)std::malloc(sizeof(PlotRange) * (rounded / BLOCK_SIZE));
+  if (this->samples == nullptr || this->blocks == nullptr) {
+    std::free(this->samples);
+    std::free(this->blocks);
+    this->samples = nullptr;
+    this->blocks = nullptr;
+    return error_codes::SDL_BAD_ALLOCATION;
+  }
+
+  this->capacity = rounded;
+  return error_codes::OK;
+}
+
+void PlotSeries::push(f32 value) noexcept {
+  if (this->capacity == 0) {
+    return;
+  }
+
+  this->samples[this->head] = value;
+  PlotRange& block = this->blocks[this->head / BLOCK_SIZE];
+  if (this->head % BLOCK_SIZE == 0) {
+    block = {value, value};
+  } else {
+    merge(block, {value, value});
+  }
+
+  this->head = this->head + 1 == this->capacity ? 0 : this->head + 1;
+  this->size = std::min(this->size + 1, this->capacity);
+}
+
+void PlotSeries::push(const f32* values, i32 count) noexcept {
+  if (this->capacity == 0 || count <= 0) {
+    return;
+  }
+
+  // Older values would be overwritten right away
+  if (count > this->capacity) {
+    values += count - this->capacity;
+    count = this->capacity;
+  }
+  this->size = std::min(this->size + count, this->capacity);
+
+  // One block at a time, without wrapping
+  while (count > 0) {
+    const i32 offset = this->head % BLOCK_SIZE;
+    const i32 length = std::min(count, BLOCK_SIZE - offset);
+    std::memcpy(this->samples + this->head, values, sizeof(f32) * length);
+
+    const PlotRange range = plot::min_max(values, length);
+    PlotRange& block = this->blocks[this->head / BLOCK_SIZE];
+    if (offset == 0) {
+      block = range;
+    } else {
+      merge(block, range);
+    }
+
+    this->head += length;
+    this->head = this->head == this->capacity ? 0 : this->head;
+    values += length;
+    count -= length;
+  }
+}
+
+void PlotSeries::clear() noexcept {
+  this->size = 0;
+  this->head = 0;
+}
+
+PlotRange PlotSeries::get_range(i32 first, i32 count) const noexcept {
+  assert(first >= 0 && count > 0 && first + count <= this->size);
+  const i32 oldest =
+      (this->head - this->size + this->capacity) % this->capacity;
+  const i32 start = (oldest + first) % this->capacity;
+  if (start + count <= this->capacity) {
+    return this->get_segment(start, start + count);
+  }
+
+  PlotRange output = this->get_segment(start, this->capacity);
+  merge(output, this->get_segment(0, start + count - this->capacity));
+  return output;
+}
+
+void PlotSeries::decimate(
+    i32 first, i32 count, PlotRange* columns, i32 column_count
+) const noexcept {
+  if (count <= 0) {
+    std::fill(columns, columns + column_count, PlotRange{});
+    return;
+  }
+
+  i32 start = 0;
+  i32 end = 0;
+  for (i32 column = 0; column < column_count; ++column) {
+    get_column(column, count, column_count, start, end);
+    columns[column] = this->get_range(first + start, end - start);
+  }
+}
+
+i32 PlotSeries::get_size() const noexcept {
+  return this->size;
+}
+
+i32 PlotSeries::get_capacity() const noexcept {
+  return this->capacity;
+}
+
+f32 PlotSeries::operator[](i32 index) const noexcept {
+  const i32 oldest =
+      (this->head - this->size + this->capacity) % this->capacity;
+  return this->samples[(oldest + index) % this->capacity];
+}
+
+// === Private === //
+
+PlotRange PlotSeries::get_segment(i32 start, i32 end) const noexcept {
+  // Blocks fully inside the segment, the one being written never is
+  const i32 first_block = (start + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  const i32 last_block = end / BLOCK_SIZE;
+  if (first_block >= last_block) {
+    return plot::min_max(this->samples + start, end - start);
+  }
+
+  PlotRange output = this->blocks[first_block];
+  for (i32 block = first_block + 1; block < last_block; ++block) {
+    merge(output, this->blocks[block]);
+  }
+
+  const i32 block_start = first_block * BLOCK_SIZE;
+  if (start < block_start) {
+    merge(output, plot::min_max(this->samples + start, block_start - start));
+  }
+  const i32 block_end = last_block * BLOCK_SIZE;
+  if (block_end < end) {
+    merge(output, plot::min_max(this->samples + block_end, end - block_end));
+  }
+  return output;
+}
+
+} // namespace immpp
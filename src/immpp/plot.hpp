@@ -0,0 +1,85 @@
+#ifndef IMMPP_PLOT_HPP
+#define IMMPP_PLOT_HPP
+
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct PlotRange {
+  f32 min = 0.0F;
+  f32 max = 0.0F;
+};
+
+namespace plot {
+
+/**
+ * Minimum and maximum of count > 0 values. Uses AVX, SSE or NEON when the
+ * compiler targets them and a scalar loop otherwise. NaN values are not
+ * supported.
+ **/
+[[nodiscard]] PlotRange min_max(const f32* values, i32 count) noexcept;
+
+// Splits the values into column_count ranges of equal length and outputs the
+// min/max of each. Columns without values take the nearest one.
+void decimate(
+    const f32* values, i32 count, PlotRange* columns, i32 column_count
+) noexcept;
+
+} // namespace plot
+
+// Ring buffer of samples for live plots, the oldest ones are overwritten
+// when it is full. The min/max of every BLOCK_SIZE samples is updated on
+// push, so decimating reads whole blocks and only scans the partial blocks
+// at the column edges instead of the entire history.
+class PlotSeries {
+public:
+  static const i32 BLOCK_SIZE = 64;
+
+  PlotSeries() noexcept = default;
+  PlotSeries(PlotSeries&& other) noexcept;
+  PlotSeries& operator=(PlotSeries&& rhs) noexcept;
+
+  PlotSeries(const PlotSeries&) = delete;
+  PlotSeries& operator=(const PlotSeries&) = delete;
+
+  ~PlotSeries() noexcept;
+
+  /**
+   * Rounded up to a multiple of BLOCK_SIZE, drops the samples.
+   *
+   * Possible errors:
+   * - SDL_BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code set_capacity(i32 capacity) noexcept;
+
+  // Does nothing without a capacity
+  void push(f32 value) noexcept;
+  void push(const f32* values, i32 count) noexcept;
+  void clear() noexcept;
+
+  // Samples [first, first + count) counted from the oldest one
+  [[nodiscard]] PlotRange get_range(i32 first, i32 count) const noexcept;
+  // Same as plot::decimate over the samples [first, first + count)
+  void decimate(
+      i32 first, i32 count, PlotRange* columns, i32 column_count
+  ) const noexcept;
+
+  [[nodiscard]] i32 get_size() const noexcept;
+  [[nodiscard]] i32 get_capacity() const noexcept;
+  // From the oldest sample
+  [[nodiscard]] f32 operator[](i32 index) const noexcept;
+
+private:
+  f32* samples = nullptr;
+  PlotRange* blocks = nullptr; // Min/max of the samples written per block
+  i32 capacity = 0;
+  i32 size = 0;
+  i32 head = 0; // Next written sample
+
+  // Physical range [start, end) without wrapping
+  [[nodiscard]] PlotRange get_segment(i32 start, i32 end) const noexcept;
+};
+
+} // namespace immpp
+
+#endif
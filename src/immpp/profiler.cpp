@@ -0,0 +1,97 @@
+#include "./profiler.hpp"
+#include "immpp/trace.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <chrono>
+
+namespace immpp {
+
+namespace {
+
+// NOLINTNEXTLINE
+std::array<profiler::FrameRecord, profiler::FRAME_HISTORY> frames{};
+i32 current_frame = 0;    // NOLINT
+i32 completed_frames = 0; // NOLINT
+i32 depth = 0;            // NOLINT
+bool in_frame = false;    // NOLINT
+
+} // namespace
+
+void profiler::begin_frame() noexcept {
+  auto& frame = frames[current_frame];
+  frame.start = get_time();
+  frame.end = 0;
+  frame.zone_count = 0;
+  frame.dropped_zones = 0;
+
+  depth = 0;
+  in_frame = true;
+}
+
+void profiler::end_frame() noexcept {
+  if (!in_frame) {
+    return;
+  }
+
+  auto& frame = frames[current_frame];
+  frame.end = get_time();
+  if (trace::is_recording()) {
+    trace::record("frame", frame.start, frame.end);
+    trace::check_trigger(frame.end - frame.start);
+  }
+
+  current_frame = (current_frame + 1) % FRAME_HISTORY;
+  if (completed_frames < FRAME_HISTORY - 1) {
+    ++completed_frames;
+  }
+  in_frame = false;
+}
+
+i32 profiler::begin_zone(const c8* name, u64 start) noexcept {
+  auto& frame = frames[current_frame];
+  if (!in_frame || frame.zone_count >= MAX_ZONES) {
+    ++frame.dropped_zones;
+    return -1;
+  }
+
+  const i32 index = frame.zone_count++;
+  frame.zones[index] = ZoneRecord{
+    .name = name, .start = start, .end = 0, .depth = depth++
+  };
+  return index;
+}
+
+void profiler::end_zone(i32 index, u64 end) noexcept {
+  if (index < 0) {
+    return;
+  }
+
+  frames[current_frame].zones[index].end = end;
+  --depth;
+}
+
+profiler::Zone::~Zone() noexcept {
+  const u64 end = get_time();
+  end_zone(this->index, end);
+  if (trace::is_recording()) {
+    trace::record(this->name, this->start, end);
+  }
+}
+
+const profiler::FrameRecord* profiler::get_frame(i32 age) noexcept {
+  if (age < 0 || age >= completed_frames) {
+    return nullptr;
+  }
+
+  const i32 index = (current_frame - 1 - age + FRAME_HISTORY) % FRAME_HISTORY;
+  return &frames[index];
+}
+
+u64 profiler::get_time() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()
+  )
+      .count();
+}
+
+} // namespace immpp
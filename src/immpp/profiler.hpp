@@ -0,0 +1,85 @@
+#ifndef IMMPP_PROFILER_HPP
+#define IMMPP_PROFILER_HPP
+
+#include "immpp/types.hpp"
+#include <array>
+
+namespace immpp::profiler {
+
+const i32 MAX_ZONES = 128;
+const i32 FRAME_HISTORY = 64;
+
+struct ZoneRecord {
+  const c8* name; // Should be a string literal
+  u64 start;      // ns
+  u64 end;        // ns
+  i32 depth;
+};
+
+struct FrameRecord {
+  u64 start = 0; // ns
+  u64 end = 0;   // ns
+  i32 zone_count = 0;
+  i32 dropped_zones = 0; // Zones over MAX_ZONES
+  std::array<ZoneRecord, MAX_ZONES> zones{};
+};
+
+// NOTE: Zones are recorded from the render thread only
+void begin_frame() noexcept;
+void end_frame() noexcept;
+
+// Returns the zone index to end, -1 if it was dropped
+[[nodiscard]] i32 begin_zone(const c8* name, u64 start) noexcept;
+void end_zone(i32 index, u64 end) noexcept;
+
+// 0 is the last completed frame, nullptr if there is no such frame
+[[nodiscard]] const FrameRecord* get_frame(i32 age) noexcept;
+[[nodiscard]] u64 get_time() noexcept;
+
+class Zone {
+public:
+  // Also recorded by immpp/trace.hpp while it is started
+  explicit Zone(const c8* name) noexcept
+      : name(name), start(get_time()), index(begin_zone(name, this->start)) {}
+  Zone(const Zone&) = delete;
+  Zone(Zone&&) = delete;
+  Zone& operator=(const Zone&) = delete;
+  Zone& operator=(Zone&&) = delete;
+
+  ~Zone() noexcept;
+
+private:
+  const c8* name;
+  u64 start;
+  i32 index;
+};
+
+} // namespace immpp::profiler
+
+// Compiled in with IMMPP_PROFILE, expands to nothing otherwise
+
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_CONCAT2(a, b) a##b
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_CONCAT(a, b) IMMPP_PROFILE_CONCAT2(a, b)
+
+#ifdef IMMPP_PROFILE
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_ZONE(name)                                               \
+  const immpp::profiler::Zone IMMPP_PROFILE_CONCAT(immpp_zone_, __LINE__) {    \
+    name                                                                       \
+  }
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_BEGIN_FRAME() immpp::profiler::begin_frame()
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_END_FRAME() immpp::profiler::end_frame()
+#else
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_ZONE(name) static_cast<void>(0)
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_BEGIN_FRAME() static_cast<void>(0)
+// NOLINTNEXTLINE
+#define IMMPP_PROFILE_END_FRAME() static_cast<void>(0)
+#endif
+
+#endif
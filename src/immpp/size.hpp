@@ -2,6 +2,7 @@
 #define IMMPP_SIZE_HPP
 
 #include "immpp/types.hpp"
+#include <cassert>
 
 namespace immpp::size {
 
@@ -10,13 +11,36 @@ namespace immpp::size {
 const i32 FIT_I32 = 0;
 const i32 GROW_I32 = 0x8000'0000;
 
-[[nodiscard]] i32 encode_fixed(i32 size) noexcept;
-[[nodiscard]] i32 decode_fixed(i32 encoded) noexcept;
-[[nodiscard]] i32 encode_grow(i32 part) noexcept;
-[[nodiscard]] i32 decode_grow(i32 encoded) noexcept;
-[[nodiscard]] i32 encode_fit() noexcept;
-[[nodiscard]] bool is_fit(i32 encoded) noexcept;
-[[nodiscard]] bool is_grow(i32 encoded) noexcept;
+// constexpr so specs can be template arguments, see Window::start_row
+
+[[nodiscard]] constexpr i32 encode_fixed(i32 size) noexcept {
+  assert(!(size & GROW_I32));
+  return size;
+}
+
+[[nodiscard]] constexpr i32 decode_fixed(i32 encoded) noexcept {
+  return encoded;
+}
+
+[[nodiscard]] constexpr i32 encode_grow(i32 part) noexcept {
+  return GROW_I32 | part;
+}
+
+[[nodiscard]] constexpr i32 decode_grow(i32 encoded) noexcept {
+  return ~GROW_I32 & encoded;
+}
+
+[[nodiscard]] constexpr i32 encode_fit() noexcept {
+  return FIT_I32;
+}
+
+[[nodiscard]] constexpr bool is_fit(i32 encoded) noexcept {
+  return FIT_I32 == encoded;
+}
+
+[[nodiscard]] constexpr bool is_grow(i32 encoded) noexcept {
+  return (GROW_I32 & encoded) != 0;
+}
 
 // === Float Sizes === //
 
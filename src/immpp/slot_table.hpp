@@ -0,0 +1,320 @@
+#ifndef IMMPP_SLOT_TABLE_HPP
+#define IMMPP_SLOT_TABLE_HPP
+
+#include "immpp/types.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace immpp {
+
+/**
+ * Linear probing table of trivially copyable entries with a u64 key, 0 marks
+ * an empty slot, and the u32 generation of their last use. Entries older than
+ * the max age in generations are removed in place with backward shifts, so
+ * there are no tombstones. When an insert would pass 3/4 load the old
+ * entries are evicted first, at most once per generation, and the table only
+ * grows when the rest is still in use. A steady working set never allocates.
+ * Entries owning resources release them in an optional remove callback.
+ **/
+template <typename Entry> class SlotTable {
+  static_assert(std::is_trivially_copyable_v<Entry>);
+
+public:
+  static constexpr i32 MIN_CAPACITY = 16;
+
+  // Called with every entry that is evicted, swept or cleared
+  using RemoveCallback = void (*)(Entry& entry) noexcept;
+
+  SlotTable() noexcept = default;
+  explicit SlotTable(
+      i32 initial_capacity, u32 generations = 1,
+      RemoveCallback callback = nullptr
+  ) noexcept
+      : max_age(generations), capacity(round_capacity(initial_capacity)),
+        on_remove(callback) {}
+
+  SlotTable(SlotTable&& other) noexcept
+      : entries(other.entries), generation(other.generation),
+        swept(other.swept), max_age(other.max_age), cursor(other.cursor),
+        count(other.count), capacity(other.capacity),
+        evictions(other.evictions), grows(other.grows),
+        on_remove(other.on_remove) {
+    other.entries = nullptr;
+    other.count = 0;
+  }
+
+  SlotTable& operator=(SlotTable&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    this->release_all();
+    std::free(this->entries);
+    this->entries = rhs.entries;
+    this->generation = rhs.generation;
+    this->swept = rhs.swept;
+    this->max_age = rhs.max_age;
+    this->cursor = rhs.cursor;
+    this->count = rhs.count;
+    this->capacity = rhs.capacity;
+    this->evictions = rhs.evictions;
+    this->grows = rhs.grows;
+    this->on_remove = rhs.on_remove;
+    rhs.entries = nullptr;
+    rhs.count = 0;
+
+    return *this;
+  }
+
+  SlotTable(const SlotTable&) = delete;
+  SlotTable& operator=(const SlotTable&) = delete;
+
+  ~SlotTable() noexcept {
+    this->release_all();
+    std::free(this->entries);
+    this->entries = nullptr;
+  }
+
+  // Rounded up to a power of 2, drops all entries. Allocated on first insert
+  void set_capacity(i32 new_capacity) noexcept {
+    this->release_all();
+    std::free(this->entries);
+    this->entries = nullptr;
+    this->capacity = round_capacity(new_capacity);
+    this->count = 0;
+    this->cursor = 0;
+  }
+
+  // Generations an entry stays after its last use, 1 keeps the previous one
+  void set_max_age(u32 generations) noexcept {
+    this->max_age = generations;
+  }
+
+  // Marks the entry as used, nullptr on a miss. Valid until the next insert
+  [[nodiscard]] Entry* find(u64 key) noexcept {
+    key = key == 0 ? 1 : key;
+    if (this->entries == nullptr) {
+      return nullptr;
+    }
+
+    Entry* entry = this->entries + this->find_slot(key);
+    if (entry->key != key) {
+      return nullptr;
+    }
+    entry->generation = this->generation;
+    return entry;
+  }
+
+  /**
+   * Marks the entry as used, new entries are zeroed apart from their key and
+   * generation. Valid until the next insert, nullptr only when the table can
+   * not be allocated or grown. is_new tells whether the key was missing.
+   **/
+  [[nodiscard]] Entry* insert(u64 key, bool* is_new = nullptr) noexcept {
+    key = key == 0 ? 1 : key;
+    if (this->entries == nullptr) {
+      this->entries = (Entry*)std::calloc(this->capacity, sizeof(Entry));
+      if (this->entries == nullptr) {
+        return nullptr;
+      }
+    }
+
+    Entry* entry = this->entries + this->find_slot(key);
+    const bool missing = entry->key != key;
+    if (missing) {
+      // Keep the load factor under 3/4 for short probes
+      if (this->is_crowded()) {
+        static_cast<void>(this->evict());
+        if (this->is_crowded() && !this->grow() &&
+            this->count + 1 >= this->capacity) {
+          return nullptr;
+        }
+        entry = this->entries + this->find_slot(key);
+      }
+
+      std::memset((void*)entry, 0, sizeof(Entry));
+      entry->key = key;
+      ++this->count;
+    }
+
+    entry->generation = this->generation;
+    if (is_new != nullptr) {
+      *is_new = missing;
+    }
+    return entry;
+  }
+
+  // Removes all old entries, only once per generation. Returns the count
+  i32 evict() noexcept {
+    if (this->entries == nullptr || this->swept == this->generation) {
+      return 0;
+    }
+    this->swept = this->generation;
+
+    i32 removed = 0;
+    for (i32 slot = 0; slot < this->capacity;) {
+      if (this->is_old(this->entries[slot])) {
+        // The next entry might be shifted into this slot, check it again
+        this->remove(slot);
+        ++removed;
+      } else {
+        ++slot;
+      }
+    }
+    return removed;
+  }
+
+  // Checks the next slots for old entries, spreads eviction over the frames
+  void sweep(i32 slots) noexcept {
+    if (this->entries == nullptr || this->count == 0) {
+      return;
+    }
+
+    const i32 mask = this->capacity - 1;
+    for (i32 i = 0; i < slots; ++i) {
+      if (this->is_old(this->entries[this->cursor])) {
+        this->remove(this->cursor);
+      } else {
+        this->cursor = (this->cursor + 1) & mask;
+      }
+    }
+  }
+
+  // Ages the entries, call once per frame
+  void next_frame() noexcept {
+    ++this->generation;
+  }
+
+  void clear() noexcept {
+    this->release_all();
+    if (this->entries != nullptr) {
+      std::memset((void*)this->entries, 0, sizeof(Entry) * this->capacity);
+    }
+    this->count = 0;
+  }
+
+  // Slots for iteration, empty ones have a key of 0
+  [[nodiscard]] Entry* get_entries() noexcept {
+    return this->entries;
+  }
+
+  [[nodiscard]] i32 get_count() const noexcept {
+    return this->count;
+  }
+
+  [[nodiscard]] i32 get_capacity() const noexcept {
+    return this->capacity;
+  }
+
+  [[nodiscard]] u64 get_evictions() const noexcept {
+    return this->evictions;
+  }
+
+  [[nodiscard]] u64 get_grows() const noexcept {
+    return this->grows;
+  }
+
+private:
+  Entry* entries = nullptr;
+  u32 generation = 1;
+  u32 swept = 0; // Generation of the last evict
+  u32 max_age = 1;
+  i32 cursor = 0; // Next slot checked by sweep
+  i32 count = 0;
+  i32 capacity = MIN_CAPACITY;
+  u64 evictions = 0;
+  u64 grows = 0;
+  RemoveCallback on_remove = nullptr;
+
+  [[nodiscard]] static i32 round_capacity(i32 value) noexcept {
+    i32 rounded = MIN_CAPACITY;
+    while (rounded < value) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  void release_all() noexcept {
+    if (this->entries == nullptr || this->on_remove == nullptr) {
+      return;
+    }
+    for (i32 i = 0; i < this->capacity; ++i) {
+      if (this->entries[i].key != 0) {
+        this->on_remove(this->entries[i]);
+      }
+    }
+  }
+
+  [[nodiscard]] bool is_crowded() const noexcept {
+    return (this->count + 1) * 4 > this->capacity * 3;
+  }
+
+  [[nodiscard]] bool is_old(const Entry& entry) const noexcept {
+    return entry.key != 0 &&
+           this->generation - entry.generation > this->max_age;
+  }
+
+  [[nodiscard]] i32 find_slot(u64 key) const noexcept {
+    const u64 mask = this->capacity - 1;
+    u64 index = key & mask;
+    while (this->entries[index].key != 0 && this->entries[index].key != key) {
+      index = (index + 1) & mask;
+    }
+    return (i32)index;
+  }
+
+  // Shifts the following entries back, no tombstones
+  void remove(i32 slot) noexcept {
+    const i32 mask = this->capacity - 1;
+    if (this->on_remove != nullptr) {
+      this->on_remove(this->entries[slot]);
+    }
+    this->entries[slot].key = 0;
+    --this->count;
+    ++this->evictions;
+
+    i32 hole = slot;
+    for (i32 next = (slot + 1) & mask; this->entries[next].key != 0;
+         next = (next + 1) & mask) {
+      // Entries whose home slot is cyclically in (hole, next] stay reachable
+      const i32 home = (i32)(this->entries[next].key & mask);
+      const bool reachable = hole <= next ? hole < home && home <= next
+                                          : hole < home || home <= next;
+      if (reachable) {
+        continue;
+      }
+
+      this->entries[hole] = this->entries[next];
+      this->entries[next].key = 0;
+      hole = next;
+    }
+  }
+
+  [[nodiscard]] bool grow() noexcept {
+    const i32 new_capacity = this->capacity * 2;
+    auto* new_entries = (Entry*)std::calloc(new_capacity, sizeof(Entry));
+    if (new_entries == nullptr) {
+      return false;
+    }
+
+    Entry* old_entries = this->entries;
+    const i32 old_capacity = this->capacity;
+    this->entries = new_entries;
+    this->capacity = new_capacity;
+    for (i32 i = 0; i < old_capacity; ++i) {
+      if (old_entries[i].key != 0) {
+        this->entries[this->find_slot(old_entries[i].key)] = old_entries[i];
+      }
+    }
+    std::free(old_entries);
+
+    this->cursor = 0;
+    ++this->grows;
+    return true;
+  }
+};
+
+} // namespace immpp
+
+#endif
@@ -0,0 +1,217 @@
+#include "./table_cache.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const immpp::i32 MIN_TEXT_CAPACITY = 4096;
+
+// Largest length up to the given one that does not split a UTF-8 sequence,
+// text[length] has to be readable
+[[nodiscard]] inline immpp::i32
+utf8_cut(const immpp::c8* text, immpp::i32 length) noexcept {
+  while (length > 0 && ((immpp::u8)text[length] & 0xc0) == 0x80) {
+    --length;
+  }
+  return length;
+}
+
+void copy_inline(
+    immpp::TableCell& cell, const immpp::c8* text, immpp::i32 length
+) noexcept {
+  if (length >= immpp::TableCell::INLINE_CAPACITY) {
+    length = utf8_cut(text, immpp::TableCell::INLINE_CAPACITY - 1);
+  }
+  std::memcpy(cell.inline_text.data(), text, length);
+  cell.inline_text[length] = '\0';
+  cell.length = length;
+}
+
+} // namespace
+
+namespace immpp {
+
+TableCache::TableCache(TableCache&& other) noexcept
+    : cells(std::move(other.cells)), texts(other.texts), spare(other.spare),
+      text_size(other.text_size), text_capacity(other.text_capacity),
+      stats(other.stats) {
+  other.texts = nullptr;
+  other.spare = nullptr;
+  other.text_size = 0;
+  other.text_capacity = 0;
+}
+
+TableCache& TableCache::operator=(TableCache&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  std::free(this->texts);
+  std::free(this->spare);
+  this->cells = std::move(rhs.cells);
+  this->texts = rhs.texts;
+  this->spare = rhs.spare;
+  this->text_size = rhs.text_size;
+  this->text_capacity = rhs.text_capacity;
+  this->stats = rhs.stats;
+  rhs.texts = nullptr;
+  rhs.spare = nullptr;
+  rhs.text_size = 0;
+  rhs.text_capacity = 0;
+
+  return *this;
+}
+
+TableCache::~TableCache() noexcept {
+  std::free(this->texts);
+  std::free(this->spare);
+  this->texts = nullptr;
+  this->spare = nullptr;
+}
+
+void TableCache::set_capacity(i32 capacity) noexcept {
+  this->cells.set_capacity(capacity);
+  this->text_size = 0;
+  this->update_stats();
+}
+
+TableCell* TableCache::find(u64 key) noexcept {
+  TableCell* cell = this->cells.find(key);
+  if (cell == nullptr) {
+    ++this->stats.misses;
+    return nullptr;
+  }
+
+  ++this->stats.hits;
+  return cell;
+}
+
+TableCell& TableCache::insert(u64 key, const c8* text, i32 length) noexcept {
+  if (length < 0) {
+    length = (i32)std::strlen(text);
+  }
+  length = utf8_cut(text, length);
+
+  // Before the insert, it can move the cells
+  const bool is_long = length >= TableCell::INLINE_CAPACITY;
+  const bool has_room = !is_long || this->reserve_text(length + 1);
+
+  TableCell* cell = this->cells.insert(key);
+  this->update_stats();
+  if (cell == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on table cache");
+    this->scratch = {};
+    copy_inline(this->scratch, text, length);
+    return this->scratch;
+  }
+
+  cell->size = {};
+  if (!is_long || !has_room) {
+    copy_inline(*cell, text, length);
+    return *cell;
+  }
+
+  cell->offset = this->text_size;
+  cell->length = length;
+  std::memcpy(this->texts + this->text_size, text, length);
+  this->texts[this->text_size + length] = '\0';
+  this->text_size += length + 1;
+  return *cell;
+}
+
+const c8* TableCache::get_text(const TableCell& cell) const noexcept {
+  return cell.length < TableCell::INLINE_CAPACITY ? cell.inline_text.data()
+                                                  : this->texts + cell.offset;
+}
+
+void TableCache::next_frame() noexcept {
+  this->cells.next_frame();
+}
+
+void TableCache::clear() noexcept {
+  this->cells.clear();
+  this->text_size = 0;
+  this->update_stats();
+}
+
+const TableCacheStats& TableCache::get_stats() const noexcept {
+  return this->stats;
+}
+
+// === Private === //
+
+bool TableCache::reserve_text(i32 bytes) noexcept {
+  if (this->text_size + bytes <= this->text_capacity) {
+    return true;
+  }
+
+  // Text of evicted and replaced cells is reclaimed by compact
+  static_cast<void>(this->cells.evict());
+  i32 used = 0;
+  const TableCell* entries = this->cells.get_entries();
+  for (i32 i = 0; entries != nullptr && i < this->cells.get_capacity(); ++i) {
+    if (entries[i].key != 0 &&
+        entries[i].length >= TableCell::INLINE_CAPACITY) {
+      used += entries[i].length + 1;
+    }
+  }
+
+  i32 capacity = std::max(this->text_capacity, MIN_TEXT_CAPACITY);
+  while (used + bytes > capacity) {
+    capacity *= 2;
+  }
+  if (capacity != this->text_capacity) {
+    c8* grown = (c8*)std::malloc(capacity);
+    c8* grown_spare = (c8*)std::malloc(capacity);
+    if (grown == nullptr || grown_spare == nullptr) {
+      std::free(grown);
+      std::free(grown_spare);
+      IMMPP_LOG_WARN("Bad Allocation on table cache text");
+      return false;
+    }
+
+    // Compacts into the grown buffer, then drops the old one
+    std::free(this->spare);
+    this->spare = grown;
+    this->compact();
+    std::free(this->spare);
+    this->spare = grown_spare;
+    this->text_capacity = capacity;
+    this->update_stats();
+    return true;
+  }
+
+  this->compact();
+  return true;
+}
+
+void TableCache::compact() noexcept {
+  TableCell* entries = this->cells.get_entries();
+  i32 size = 0;
+  for (i32 i = 0; entries != nullptr && i < this->cells.get_capacity(); ++i) {
+    TableCell& cell = entries[i];
+    if (cell.key == 0 || cell.length < TableCell::INLINE_CAPACITY) {
+      continue;
+    }
+
+    std::memcpy(this->spare + size, this->texts + cell.offset, cell.length + 1);
+    cell.offset = size;
+    size += cell.length + 1;
+  }
+
+  std::swap(this->texts, this->spare);
+  this->text_size = size;
+}
+
+void TableCache::update_stats() noexcept {
+  this->stats.evictions = this->cells.get_evictions();
+  this->stats.grows = this->cells.get_grows();
+  this->stats.count = this->cells.get_count();
+  this->stats.capacity = this->cells.get_capacity();
+  this->stats.text_capacity = this->text_capacity;
+}
+
+} // namespace immpp
@@ -0,0 +1,98 @@
+#ifndef IMMPP_TABLE_CACHE_HPP
+#define IMMPP_TABLE_CACHE_HPP
+
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+#include <array>
+
+namespace immpp {
+
+struct TableCacheStats {
+  u64 hits = 0;
+  u64 misses = 0;
+  u64 evictions = 0;
+  u64 grows = 0;
+  i32 count = 0;
+  i32 capacity = 0;
+  i32 text_capacity = 0; // Bytes for the text of long cells
+
+  [[nodiscard]] f32 get_hit_rate() const noexcept {
+    const u64 total = this->hits + this->misses;
+    return total == 0 ? 0.0F : (f32)this->hits / (f32)total;
+  }
+};
+
+struct TableCell {
+  static const i32 INLINE_CAPACITY = 68; // With the terminator
+
+  u64 key; // 0 marks an empty slot
+  u32 generation;
+  i32 length;     // Bytes, the text is inline when under INLINE_CAPACITY
+  vec2<i32> size; // Filled by the caller after insert
+  i32 offset;     // Of longer text in the side buffer of the cache
+  std::array<c8, INLINE_CAPACITY> inline_text;
+};
+
+/**
+ * Cell text of tables keyed by the caller, usually the table, row, column
+ * and font. Short text is stored in the cell, longer text in a side buffer
+ * that is compacted when it fills up and only grows when the text of the
+ * cells in use does not fit. Cells not used in the current or previous frame
+ * are evicted first, like the text cache.
+ **/
+class TableCache {
+public:
+  static const i32 DEFAULT_CAPACITY = 4096; // Cells, power of 2
+
+  TableCache() noexcept = default;
+  TableCache(TableCache&& other) noexcept;
+  TableCache& operator=(TableCache&& rhs) noexcept;
+
+  TableCache(const TableCache&) = delete;
+  TableCache& operator=(const TableCache&) = delete;
+
+  ~TableCache() noexcept;
+
+  // Starting capacity rounded up to a power of 2, drops all entries
+  void set_capacity(i32 capacity) noexcept;
+
+  // nullptr on a miss, valid until the next insert
+  [[nodiscard]] TableCell* find(u64 key) noexcept;
+  /**
+   * Copies length bytes of the text, all of it when negative, cut back to a
+   * UTF-8 boundary. Falls back to a scratch cell with text cut to the inline
+   * capacity when the cache can not be allocated. Valid until the next insert
+   **/
+  [[nodiscard]] TableCell&
+  insert(u64 key, const c8* text, i32 length = -1) noexcept;
+  // Null terminated text of a cell
+  [[nodiscard]] const c8* get_text(const TableCell& cell) const noexcept;
+
+  // Advances the generation used for eviction, call once per frame
+  void next_frame() noexcept;
+  void clear() noexcept;
+
+  [[nodiscard]] const TableCacheStats& get_stats() const noexcept;
+
+private:
+  SlotTable<TableCell> cells{DEFAULT_CAPACITY};
+  TableCell scratch{};
+
+  // Text of long cells and the target of compact, both of text_capacity
+  c8* texts = nullptr;
+  c8* spare = nullptr;
+  i32 text_size = 0;
+  i32 text_capacity = 0;
+
+  TableCacheStats stats{.capacity = DEFAULT_CAPACITY};
+
+  // Makes room for bytes of long text, false if it could not grow
+  [[nodiscard]] bool reserve_text(i32 bytes) noexcept;
+  // Copies the text of the cells into spare and swaps the buffers
+  void compact() noexcept;
+  void update_stats() noexcept;
+};
+
+} // namespace immpp
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef IMMPP_TEXT_CACHE_HPP
+#define IMMPP_TEXT_CACHE_HPP
+
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct TextMeasure {
+  vec2<i32> size;
+  i32 length;
+};
+
+struct TextCacheStats {
+  u64 hits = 0;
+  u64 misses = 0;
+  u64 evictions = 0;
+  u64 grows = 0;
+  i32 count = 0;
+  i32 capacity = 0;
+
+  [[nodiscard]] f32 get_hit_rate() const noexcept {
+    const u64 total = this->hits + this->misses;
+    return total == 0 ? 0.0F : (f32)this->hits / (f32)total;
+  }
+};
+
+// Measured string extents keyed by the string hash and the font/size. A
+// 64 bit hash collision between strings of the same length returns the wrong
+// extents, that is accepted. Entries not used in the current or previous
+// frame are evicted in place when the table fills up, it only grows when more
+// strings than that are in use.
+class TextCache {
+public:
+  static const i32 DEFAULT_CAPACITY = 1024;
+
+  TextCache() noexcept = default;
+  TextCache(TextCache&& other) noexcept = default;
+  TextCache& operator=(TextCache&& rhs) noexcept = default;
+
+  TextCache(const TextCache&) = delete;
+  TextCache& operator=(const TextCache&) = delete;
+
+  ~TextCache() noexcept = default;
+
+  // Starting capacity rounded up to a power of 2, drops all entries
+  void set_capacity(i32 capacity) noexcept;
+
+  [[nodiscard]] TextMeasure measure(TTF_Font* font, const c8* text) noexcept;
+
+  // Advances the generation used for eviction, call once per frame
+  void next_frame() noexcept;
+  void clear() noexcept;
+
+  [[nodiscard]] const TextCacheStats& get_stats() const noexcept;
+
+private:
+  struct Entry {
+    u64 key; // 0 marks an empty slot
+    u32 generation;
+    TextMeasure measure;
+  };
+
+  SlotTable<Entry> entries{DEFAULT_CAPACITY};
+  TextCacheStats stats{.capacity = DEFAULT_CAPACITY};
+
+  void update_stats() noexcept;
+};
+
+} // namespace immpp
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef IMMPP_TEXT_OBJECTS_HPP
+#define IMMPP_TEXT_OBJECTS_HPP
+
+#include "SDL3/SDL_render.h"
+#include "SDL3_ttf/SDL_ttf.h"
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct TextObjectStats {
+  u64 hits = 0;    // Drawn as they were
+  u64 updates = 0; // String, font or color changed
+  u64 creates = 0;
+  u64 evictions = 0;
+  i32 count = 0;
+  i32 capacity = 0;
+};
+
+// Retained TTF_Text objects of the SDL_ttf renderer text engine, which keeps
+// the shaped text and its glyph atlas on the renderer side. Objects are
+// keyed by a caller id, or by the font and string when the id is 0.
+class TextObjects {
+public:
+  static const i32 INITIAL_CAPACITY = 256;
+  // Objects unused for this many frames are destroyed in place when the
+  // table fills, it only grows when the rest is still in use
+  static const u32 EVICT_FRAMES = 60;
+
+  TextObjects() noexcept = default;
+  TextObjects(TextObjects&& other) noexcept;
+  TextObjects& operator=(TextObjects&& rhs) noexcept;
+
+  TextObjects(const TextObjects&) = delete;
+  TextObjects& operator=(const TextObjects&) = delete;
+
+  ~TextObjects() noexcept;
+
+  /**
+   * Returns the object of the id, creating it on a miss and updating it
+   * only when the string, font or color changed.
+   * Returns nullptr if the object could not be created.
+   **/
+  [[nodiscard]] TTF_Text* get(
+      SDL_Renderer* renderer, u64 id, TTF_Font* font, const c8* text,
+      i32 length, rgba8 color
+  ) noexcept;
+
+  // Advances the generation used for eviction, call once per frame
+  void next_frame() noexcept;
+  void clear() noexcept;
+  // Also destroys the text engine, call before destroying the renderer
+  void destroy() noexcept;
+
+  [[nodiscard]] const TextObjectStats& get_stats() const noexcept;
+
+private:
+  struct Entry {
+    u64 key; // 0 marks an empty slot
+    u64 content;
+    TTF_Font* font;
+    TTF_Text* text;
+    rgba8 color;
+    u32 generation;
+  };
+
+  TTF_TextEngine* engine = nullptr;
+  SlotTable<Entry> entries{INITIAL_CAPACITY, EVICT_FRAMES, destroy_entry};
+  TextObjectStats stats{.capacity = INITIAL_CAPACITY};
+
+  static void destroy_entry(Entry& entry) noexcept;
+  void update_stats() noexcept;
+};
+
+} // namespace immpp
+
+#endif
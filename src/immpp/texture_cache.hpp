@@ -0,0 +1,62 @@
+#ifndef IMMPP_TEXTURE_CACHE_HPP
+#define IMMPP_TEXTURE_CACHE_HPP
+
+#include "SDL3/SDL_render.h"
+#include "ds/vector.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+struct TextureCacheStats {
+  u64 hits = 0;
+  u64 misses = 0;
+  u64 bytes = 0; // Estimated GPU memory of the cached textures
+  i32 count = 0; // Loaded textures, cached failures are not counted
+};
+
+// Path keyed texture store, each image is decoded once and reused until it
+// is invalidated or the cache is cleared
+class TextureCache {
+public:
+  TextureCache() noexcept = default;
+  TextureCache(TextureCache&& other) noexcept = default;
+  TextureCache& operator=(TextureCache&& rhs) noexcept;
+
+  TextureCache(const TextureCache&) = delete;
+  TextureCache& operator=(const TextureCache&) = delete;
+
+  ~TextureCache() noexcept;
+
+  /**
+   * Returns the cached texture of the image, loading it on a miss.
+   * Returns nullptr if the image could not be loaded, the failure is cached
+   * until the path is invalidated.
+   **/
+  [[nodiscard]] SDL_Texture*
+  get(SDL_Renderer* renderer, const c8* path) noexcept;
+
+  // Destroys the texture of the image, the next get would reload it
+  void invalidate(const c8* path) noexcept;
+  void clear() noexcept;
+
+  [[nodiscard]] const TextureCacheStats& get_stats() const noexcept;
+  void reset_counters() noexcept;
+
+private:
+  struct Entry {
+    u64 hash;
+    c8* path;
+    SDL_Texture* texture;
+    u64 bytes;
+  };
+
+  ds::vector<Entry> entries{};
+  TextureCacheStats stats{};
+
+  [[nodiscard]] i32 find(u64 hash, const c8* path) const noexcept;
+  void destroy_entry(Entry& entry) noexcept;
+};
+
+} // namespace immpp
+
+#endif
@@ -0,0 +1,136 @@
+#include "./trace.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <atomic>
+#include <cstdio>
+
+namespace immpp {
+
+namespace {
+
+const u64 MASK = trace::CAPACITY - 1;
+
+// Sequence is 2 * index + 1 while the slot is written and 2 * index + 2 once
+// it is complete, readers skip slots that changed under them
+struct Slot {
+  std::atomic<u64> sequence{0};
+  std::atomic<const c8*> name{nullptr};
+  std::atomic<u64> start{0};
+  std::atomic<u64> end{0};
+  std::atomic<u32> thread{0};
+};
+
+// NOLINTNEXTLINE
+std::array<Slot, trace::CAPACITY> slots{};
+std::atomic<u64> head{0};             // NOLINT
+std::atomic<bool> recording{false};   // NOLINT
+std::atomic<u32> thread_counter{0};   // NOLINT
+
+u64 trigger_threshold = 0;    // NOLINT
+const c8* trigger_path = nullptr; // NOLINT
+
+[[nodiscard]] u32 get_thread_id() noexcept {
+  thread_local u32 thread_id =
+      thread_counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  return thread_id;
+}
+
+} // namespace
+
+void trace::start() noexcept {
+  recording.store(true, std::memory_order_relaxed);
+}
+
+void trace::stop() noexcept {
+  recording.store(false, std::memory_order_relaxed);
+}
+
+bool trace::is_recording() noexcept {
+  return recording.load(std::memory_order_relaxed);
+}
+
+void trace::record(const c8* name, u64 start, u64 end) noexcept {
+  const u64 index = head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots[index & MASK];
+
+  slot.sequence.store((index * 2) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  slot.thread.store(get_thread_id(), std::memory_order_relaxed);
+  slot.sequence.store((index * 2) + 2, std::memory_order_release);
+}
+
+opt_error trace::write_chrome_json(const c8* path) noexcept {
+  FILE* file = std::fopen(path, "w");
+  if (file == nullptr) {
+    return opt_error{error_codes::UNKNOWN};
+  }
+
+  const u64 last = head.load(std::memory_order_acquire);
+  const u64 first = last > CAPACITY ? last - CAPACITY : 0;
+
+  std::fprintf(file, "{\"traceEvents\":[\n");
+  bool first_event = true;
+  for (u64 index = first; index < last; ++index) {
+    const Slot& slot = slots[index & MASK];
+    const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != (index * 2) + 2) {
+      continue;
+    }
+
+    const c8* name = slot.name.load(std::memory_order_relaxed);
+    const u64 start = slot.start.load(std::memory_order_relaxed);
+    const u64 end = slot.end.load(std::memory_order_relaxed);
+    const u32 thread = slot.thread.load(std::memory_order_relaxed);
+
+    // Overwritten while reading
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    // Timestamps are in microseconds
+    std::fprintf(
+        file,
+        "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+        "\"pid\":1,\"tid\":%u}",
+        first_event ? "" : ",\n", name, start / 1e3, (end - start) / 1e3,
+        thread
+    );
+    first_event = false;
+  }
+  std::fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+  if (std::fclose(file) != 0) {
+    return opt_error{error_codes::UNKNOWN};
+  }
+  return ds::null;
+}
+
+void trace::set_trigger(u64 threshold_ns, const c8* path) noexcept {
+  trigger_threshold = threshold_ns;
+  trigger_path = path;
+}
+
+void trace::check_trigger(u64 frame_ns) noexcept {
+  if (trigger_threshold == 0 || frame_ns <= trigger_threshold ||
+      !is_recording()) {
+    return;
+  }
+
+  // Fire once, the dump itself would trigger the next frame
+  trigger_threshold = 0;
+  if (write_chrome_json(trigger_path)) {
+    IMMPP_LOG_WARN("Could not write the trace to '%s'", trigger_path);
+    return;
+  }
+  IMMPP_LOG_INFO(
+      "Frame took %.2f ms, trace written to '%s'", frame_ns / 1e6,
+      trigger_path
+  );
+}
+
+} // namespace immpp
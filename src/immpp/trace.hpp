@@ -0,0 +1,39 @@
+#ifndef IMMPP_TRACE_HPP
+#define IMMPP_TRACE_HPP
+
+#include "immpp/types.hpp"
+
+namespace immpp::trace {
+
+// Power of 2, older events are overwritten
+const i32 CAPACITY = 1 << 15;
+
+/**
+ * Records the profiler zones (see immpp/profiler.hpp) into a lock-free ring
+ * buffer while started. Recording needs IMMPP_PROFILE to be defined.
+ **/
+void start() noexcept;
+void stop() noexcept;
+[[nodiscard]] bool is_recording() noexcept;
+
+// Safe to call from any thread, name should be a string literal
+void record(const c8* name, u64 start, u64 end) noexcept;
+
+/**
+ * Writes the buffered events in the Chrome Trace Event format, it can be
+ * opened in chrome://tracing or ui.perfetto.dev.
+ *
+ * Possible errors:
+ * - UNKNOWN, the file could not be written
+ **/
+[[nodiscard]] opt_error write_chrome_json(const c8* path) noexcept;
+
+// Dumps to path once when a frame takes longer than threshold_ns.
+// 0 disarms the trigger.
+void set_trigger(u64 threshold_ns, const c8* path) noexcept;
+// Called by the profiler at the end of every frame
+void check_trigger(u64 frame_ns) noexcept;
+
+} // namespace immpp::trace
+
+#endif
@@ -83,6 +83,12 @@ template <typename T> struct rect {
     return point.x >= this->x && point.x <= this->x + this->w &&
            point.y >= this->y && point.y <= this->y + this->h;
   }
+
+  // Shares some area, touching edges do not count
+  bool overlaps(const rect<T>& other) const noexcept {
+    return this->x < other.x + other.w && other.x < this->x + this->w &&
+           this->y < other.y + other.h && other.y < this->y + this->h;
+  }
 };
 
 struct rgba8 {
@@ -0,0 +1,57 @@
+#include "./widget_state.hpp"
+#include "immpp/logger.hpp"
+#include "immpp/types.hpp"
+
+namespace immpp {
+
+WidgetState& WidgetStore::get(WidgetId id) noexcept {
+  static_assert(sizeof(Entry) == 64, "Entries should fill a cache line");
+  bool is_new = false;
+  Entry* entry = this->entries.insert(id, &is_new);
+  if (entry == nullptr) {
+    IMMPP_LOG_WARN("Bad Allocation on widget states");
+    this->scratch = {};
+    return this->scratch;
+  }
+
+  if (is_new) {
+    ++this->stats.created;
+    this->update_stats();
+  }
+  return entry->state;
+}
+
+WidgetState* WidgetStore::find(WidgetId id) noexcept {
+  Entry* entry = this->entries.find(id);
+  return entry != nullptr ? &entry->state : nullptr;
+}
+
+void WidgetStore::next_frame() noexcept {
+  this->entries.next_frame();
+  this->entries.sweep(SWEEP_SLOTS);
+  this->update_stats();
+}
+
+void WidgetStore::set_max_age(u32 frames) noexcept {
+  this->entries.set_max_age(frames);
+}
+
+void WidgetStore::clear() noexcept {
+  this->entries.clear();
+  this->update_stats();
+}
+
+const WidgetStoreStats& WidgetStore::get_stats() const noexcept {
+  return this->stats;
+}
+
+// === Private === //
+
+void WidgetStore::update_stats() noexcept {
+  this->stats.collected = this->entries.get_evictions();
+  this->stats.grows = this->entries.get_grows();
+  this->stats.count = this->entries.get_count();
+  this->stats.capacity = this->entries.get_capacity();
+}
+
+} // namespace immpp
@@ -0,0 +1,77 @@
+#ifndef IMMPP_WIDGET_STATE_HPP
+#define IMMPP_WIDGET_STATE_HPP
+
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+#include <array>
+
+namespace immpp {
+
+// Hash of a widget label within the pushed ids, 0 is never stored
+using WidgetId = u64;
+
+// Zeroed when a widget is used for the first time
+struct WidgetState {
+  f64 scroll;                // Pixels, scroll regions and tables
+  u32 version;               // Tables, bumped to drop their cached cells
+  u32 flags;                 // Free for custom widgets
+  std::array<f32, 8> values; // Free for custom widgets, e.g. animations
+};
+
+struct WidgetStoreStats {
+  u64 created = 0;
+  u64 collected = 0; // Not used for the max age
+  u64 grows = 0;
+  i32 count = 0;
+  i32 capacity = 0;
+};
+
+// Widget states kept across frames in a slot table of one cache line per
+// entry. Entries not used for max_age frames are collected a few slots per
+// frame, and all at once before the table would grow, so lookups stay O(1)
+// and frames with the same widgets do not allocate.
+class WidgetStore {
+public:
+  static const i32 DEFAULT_CAPACITY = 256; // Entries, power of 2
+  static const u32 DEFAULT_MAX_AGE = 120;  // Frames
+  static const i32 SWEEP_SLOTS = 32;       // Checked per frame
+
+  WidgetStore() noexcept = default;
+  WidgetStore(WidgetStore&& other) noexcept = default;
+  WidgetStore& operator=(WidgetStore&& rhs) noexcept = default;
+
+  WidgetStore(const WidgetStore&) = delete;
+  WidgetStore& operator=(const WidgetStore&) = delete;
+
+  ~WidgetStore() noexcept = default;
+
+  // Created on first use, valid until the next get. Falls back to a scratch
+  // state when the table can not be allocated
+  [[nodiscard]] WidgetState& get(WidgetId id) noexcept;
+  // nullptr without a state, counts as a use
+  [[nodiscard]] WidgetState* find(WidgetId id) noexcept;
+
+  // Ages the states and collects some of the old ones, call once per frame
+  void next_frame() noexcept;
+  void set_max_age(u32 frames) noexcept;
+  void clear() noexcept;
+
+  [[nodiscard]] const WidgetStoreStats& get_stats() const noexcept;
+
+private:
+  struct Entry {
+    WidgetId key;   // 0 marks an empty slot
+    u32 generation; // Frame of the last use
+    WidgetState state;
+  };
+
+  SlotTable<Entry> entries{DEFAULT_CAPACITY, DEFAULT_MAX_AGE};
+  WidgetState scratch{};
+  WidgetStoreStats stats{.capacity = DEFAULT_CAPACITY};
+
+  void update_stats() noexcept;
+};
+
+} // namespace immpp
+
+#endif
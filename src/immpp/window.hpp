@@ -1,9 +1,25 @@
+#include "SDL3/SDL_events.h"
 #include "SDL3/SDL_render.h"
+#include "SDL3/SDL_surface.h"
 #include "SDL3/SDL_video.h"
 #include "SDL3_ttf/SDL_ttf.h"
 #include "ds/vector.hpp"
+#include "immpp/draw_list.hpp"
+#include "immpp/font_registry.hpp"
+#include "immpp/frame_arena.hpp"
+#include "immpp/frame_pacer.hpp"
+#include "immpp/glyph_atlas.hpp"
+#include "immpp/layout.hpp"
+#include "immpp/layout_cache.hpp"
+#include "immpp/plot.hpp"
 #include "immpp/size.hpp"
+#include "immpp/table_cache.hpp"
+#include "immpp/text_cache.hpp"
+#include "immpp/text_objects.hpp"
+#include "immpp/texture_cache.hpp"
 #include "immpp/types.hpp"
+#include "immpp/widget_state.hpp"
+#include <type_traits>
 
 namespace immpp {
 
@@ -42,43 +58,89 @@ struct Input {
   } keyboard;
 };
 
-enum Alignment : u8 {
-  // Horizontal
-  HORIZONTAL_LEFT = 0x00,
-  HORIZONTAL_CENTER = 0x01,
-  HORIZONTAL_RIGHT = 0x02,
-  HORIZONTAL_MASK = 0x03,
-
-  // Vertical
-  VERTICAL_TOP = 0x00,
-  VERTICAL_CENTER = 0x10,
-  VERTICAL_BOTTOM = 0x20,
-  VERTICAL_MASK = 0x30,
-};
-
 enum class Widget : u8 {
   NONE = 0,
   ROW,
   COLUMN,
   GROUP,
+  SCROLL,
+};
+
+struct CullStats {
+  i32 drawn = 0;
+  i32 culled = 0; // Fully outside the window, group or scroll clip
+};
+
+struct ScrollRegion {
+  rect<f32> area;
+  rect<f32> previous_clip;
+  f64 content;
+  f64 offset;
+};
+
+// Table being built, tables are widgets so they do not nest
+struct TableFrame {
+  rect<f32> area;
+  rect<f32> previous_clip;
+  f64 content;
+  f64 offset;
+  u64 key;     // Table id, version and font
+  f32 top;     // Position of the first visible body row
+  f32 header;  // Height of the header rows
+  f32 row_height;
+  i32 header_rows;
+  i32 first;
 };
 
 struct State {
   vec2<f32> window_size{640.0F, 480.0F};
-  ds::vector<rect<f32>> widget_sizes{};
-  ds::vector<Widget> widgets{};
+  // Backed by the frame arena after init
+  FrameVector<rect<f32>> widget_sizes{};
+  FrameVector<Widget> widgets{};
   rect<f32> limits{};
 
-  u64 time = 0;
-  u32 seconds_per_frame = 1000 / 60;
-  // u32 FPS = 60;
+  // Widgets outside the clip are hit-tested but not drawn
+  rect<f32> clip{};
+  CullStats culling{};
+  CullStats last_culling{};
+
+  // Pushed ids, each one already hashed with the previous
+  FrameVector<WidgetId> ids{};
+  i32 dropped_ids = 0; // Pushes that did not fit, popped first
+
+  FrameVector<ScrollRegion> scroll_regions{};
+
+  // Column rectangles of the current table in reverse order
+  FrameVector<rect<f32>> table_columns{};
+  TableFrame table{};
+
+  // Fonts
+  FontHandle default_font = INVALID_FONT;
+  ds::vector<FontHandle> font_stack{};
+  i32 dropped_fonts = 0; // Pushes that did not fit, popped first
+
   u8 alignments = HORIZONTAL_LEFT | VERTICAL_TOP;
   bool running = true;
+
+  // Idle mode
+  i32 idle_timeout = -1; // ms, -1 waits until the next event
+  u8 idle_frames = 0;    // Frames in a row without events or redraw requests
+  bool idle_mode = false;
+  bool redraw_requested = false;
+
+  // Draw text through retained TTF_Text objects instead of the glyph atlas
+  bool retained_text = false;
+  u32 text_count = 0; // Texts drawn in the frame, for their object ids
+
+  // Headless mode
+  u64 time = 0; // ns, programmable clock
+  bool headless = false;
 };
 
 class Window {
 public:
   Window() noexcept = default;
+  // Between frames, the per frame data is dropped
   Window(Window&& other) noexcept;
   Window& operator=(Window&& rhs) noexcept;
 
@@ -90,13 +152,44 @@ public:
    * - SDL_INIT_ERROR
    **/
   [[nodiscard]] opt_error init(const c8* title) noexcept;
+  /**
+   * Renders with the software renderer into an offscreen surface of a fixed
+   * size. The frame limiter is off and get_time follows the programmable
+   * clock instead of the system one.
+   *
+   * Possible errors:
+   * - SDL_INIT_ERROR
+   **/
+  [[nodiscard]] opt_error init_headless(vec2<i32> size) noexcept;
   ~Window() noexcept;
 
   // === Configuration === //
 
   void set_fps(u32 FPS) noexcept;
+  /**
+   * When enabled, start blocks until an event arrives once a couple of
+   * frames passed without input or redraw requests. A timeout_ms other
+   * than -1 still renders a frame at least every timeout_ms.
+   **/
+  void set_idle_mode(bool enabled, i32 timeout_ms = -1) noexcept;
+  // Loads the font and makes it the default one of the widgets
   [[nodiscard]] opt_error set_font(const c8* path, i32 size) noexcept;
   void set_window_size(vec2<i32> size) noexcept;
+  /**
+   * Draws text with retained TTF_Text objects of the SDL_ttf renderer text
+   * engine, unchanged strings skip shaping and glyph lookups entirely. An
+   * object belongs to the position of its text in the frame and id scope, so
+   * a changing label like a timer updates its object in place. Each string
+   * is drawn on its own: the queued quads are flushed before every text,
+   * which costs a batch per text compared to the glyph atlas.
+   **/
+  void set_retained_text(bool enabled) noexcept;
+  /**
+   * Starting size of the per frame arena behind the layout stack, draw
+   * commands and formatted strings, applied on the next start. A frame that
+   * does not fit still works and grows the arena for the next ones.
+   **/
+  void set_frame_arena_capacity(u64 bytes) noexcept;
 
   // === Main Loop === //
 
@@ -104,6 +197,50 @@ public:
   void end() noexcept;
   void quit() noexcept;
 
+  // Keeps the next frame from blocking in idle mode
+  void request_redraw() noexcept;
+  // Same as request_redraw, call every frame while something animates
+  void request_animation_frame() noexcept;
+  // Wakes a blocked start, safe to call from other threads
+  void wake() noexcept;
+
+  // Start of the current frame in ns
+  [[nodiscard]] u64 get_time() const noexcept;
+
+  // printf style string in the frame arena, valid until the next start
+  [[nodiscard]] const c8* format(const c8* format, ...) noexcept;
+
+  // === Headless === //
+
+  // Programmable clock, only used in headless mode
+  void set_time(u64 time_ns) noexcept;
+  void advance_time(u64 delta_ns) noexcept;
+
+  // Queued events are handled on the next start
+  void inject_event(const SDL_Event& event) noexcept;
+  void inject_mouse_motion(vec2<f32> position) noexcept;
+  void inject_mouse_button(u8 button, bool down, vec2<f32> position) noexcept;
+  void inject_mouse_wheel(vec2<f32> delta) noexcept;
+  void inject_key(u32 key, bool down) noexcept;
+
+  // The rendered frame after end, nullptr if not headless
+  [[nodiscard]] const SDL_Surface* get_framebuffer() const noexcept;
+
+  // === Ids === //
+
+  // Ids of the widgets until pop_id are hashed with the pushed one, so the
+  // same label in different lists or loop iterations gets its own state
+  void push_id(const c8* label) noexcept;
+  void push_id(const void* pointer) noexcept;
+  void push_id(i32 index) noexcept;
+  void pop_id() noexcept;
+  [[nodiscard]] WidgetId get_id(const c8* label) const noexcept;
+
+  // Created zeroed on first use and valid until the next get_state. States
+  // not used for the max age in frames are dropped.
+  [[nodiscard]] WidgetState& get_state(WidgetId id) noexcept;
+  void set_state_max_age(u32 frames) noexcept;
+
   // === Layouts === //
 
   // Check on Alignment enum for values
@@ -111,16 +248,43 @@ public:
 
   void start_row(const i32* widths, i32 widths_size) noexcept;
   void start_row(const ds::vector<i32>& widths) noexcept;
+  // Totals of the specs are computed at compile time, e.g.
+  // start_row<size::encode_fixed(64), size::encode_grow(1)>()
+  template <i32... Widths> void start_row() noexcept;
   void end_row() noexcept;
 
   void start_column(const i32* heights, i32 heights_size) noexcept;
   void start_column(const ds::vector<i32>& heights) noexcept;
+  template <i32... Heights> void start_column() noexcept;
   void end_column() noexcept;
 
   void start_group(vec2<i32> size = {size::GROW_I32, size::GROW_I32}) noexcept;
   void add_group(const rect<f32>& rectangle) noexcept;
   void end_group() noexcept;
 
+  /**
+   * Scrolled list of item_count items of item_height in the next widget
+   * size, clipped to it. The mouse wheel scrolls the hovered region and the
+   * offset is kept per id. Only the returned range of items gets widget
+   * sizes, one per item in order, so the frame cost follows the viewport.
+   **/
+  [[nodiscard]] ScrollRange
+  start_scroll(const c8* id, i32 item_count, f32 item_height) noexcept;
+  void end_scroll() noexcept;
+  // Pixels from the top, clamped on the next start_scroll
+  void set_scroll(const c8* id, f64 offset) noexcept;
+
+  // === Fonts === //
+
+  /**
+   * Loads the font without changing the current one, faces are read once
+   * and shared by all their sizes. Returns INVALID_FONT on failure.
+   **/
+  [[nodiscard]] FontHandle load_font(const c8* path, i32 size) noexcept;
+  // Widgets use the top font until it is popped, the stack resets on start
+  void push_font(FontHandle font) noexcept;
+  void pop_font() noexcept;
+
   // === Widgets === //
 
   void text(const c8* string) noexcept;
@@ -129,15 +293,225 @@ public:
   [[nodiscard]] bool image_button(const c8* path) noexcept;
   void rectangle(rgba8 color) noexcept;
   void fill_rectangle(rgba8 color) noexcept;
+  /**
+   * Table of row_count rows in the next widget size with columns laid out
+   * like start_row. The first header_rows rows stay on top while the rest
+   * scrolls with the mouse wheel. cell(row, column) returns the text of a
+   * cell and is only called for visible cells missing from the table cache,
+   * the returned string only has to live until the call returns.
+   **/
+  template <typename Cell>
+  void table(
+      const c8* id, const i32* widths, i32 widths_size, i32 row_count,
+      i32 header_rows, Cell&& cell
+  ) noexcept;
+  template <typename Cell>
+  void table(
+      const c8* id, const ds::vector<i32>& widths, i32 row_count,
+      i32 header_rows, Cell&& cell
+  ) noexcept;
+  // Calls cell again for all cells of the table, e.g. after its data changed
+  void invalidate_table(const c8* id) noexcept;
+  // Line plot in the next widget size decimated to its pixel columns, one
+  // quad each. A range with min >= max fits the plotted values.
+  void
+  plot(const PlotSeries& series, rgba8 color, PlotRange range = {}) noexcept;
+  void plot(
+      const f32* values, i32 count, rgba8 color, PlotRange range = {}
+  ) noexcept;
+  // Zones of the last frame by depth, recent frame times and counters.
+  // Needs IMMPP_PROFILE to be defined.
+  void profiler_overlay() noexcept;
+
+  // === Stats === //
+
+  // Quads, batches and SDL render calls of the last presented frame
+  [[nodiscard]] const DrawListStats& get_draw_stats() const noexcept;
+  // Widgets drawn and skipped for being clipped in the last frame
+  [[nodiscard]] const CullStats& get_cull_stats() const noexcept;
+  // Frame time percentiles of the recent frames and missed deadlines
+  [[nodiscard]] FrameTimeStats get_frame_time_stats() const noexcept;
+  // Bytes used by the frames and their high water mark
+  [[nodiscard]] const FrameArenaStats& get_frame_arena_stats() const noexcept;
+
+  // === Caches === //
+
+  // Reloads the image on its next use, call when the file changed on disk
+  void invalidate_image(const c8* path) noexcept;
+  void clear_image_cache() noexcept;
+  [[nodiscard]] const TextureCacheStats& get_image_cache_stats() const noexcept;
+  [[nodiscard]] const GlyphAtlasStats& get_glyph_atlas_stats() const noexcept;
+
+  // Starting capacity, it grows when the strings of the current and previous
+  // frame do not fit. Drops all measured text extents
+  void set_text_cache_capacity(i32 capacity) noexcept;
+  [[nodiscard]] const TextCacheStats& get_text_cache_stats() const noexcept;
+  [[nodiscard]] const TextObjectStats& get_text_object_stats() const noexcept;
+  // Retained states of the widgets, e.g. scroll offsets
+  [[nodiscard]] const WidgetStoreStats& get_widget_store_stats() const noexcept;
+  // Drops all cached table cells
+  void set_table_cache_capacity(i32 capacity) noexcept;
+  [[nodiscard]] const TableCacheStats& get_table_cache_stats() const noexcept;
+  // Rows and columns replayed from the previous frames, resizes clear it
+  [[nodiscard]] const LayoutCacheStats& get_layout_cache_stats() const noexcept;
+
+  // Loaded font files and their memory
+  [[nodiscard]] i32 get_font_face_count() const noexcept;
+  [[nodiscard]] FontFaceStats get_font_face_stats(i32 face) const noexcept;
 
 private:
   SDL_Window* window = nullptr;
   SDL_Renderer* renderer = nullptr;
-  TTF_Font* font = nullptr;
+  SDL_Surface* surface = nullptr; // Render target in headless mode
+  TTF_Font* font = nullptr; // Current font, owned by fonts
+  FontRegistry fonts{};
+  FramePacer pacer{};
+  FrameArena arena{};
+  DrawList draws{};
+  TextureCache textures{};
+  GlyphAtlas glyphs{};
+  TextCache texts{};
+  TextObjects text_objects{};
+  LayoutCache layouts{};
+  TableCache tables{};
+  WidgetStore widget_states{};
 
   Theme theme{};
   Input input{};
   State state{};
+
+  // Releases the SDL objects and everything created with them
+  void destroy() noexcept;
+  // id keys the retained object, see next_text_id
+  void draw_text(
+      WidgetId id, const c8* text, i32 length, vec2<f32> position,
+      rgba8 color
+  ) noexcept;
+  // Id of the next text in the current id scope, stable across frames
+  [[nodiscard]] WidgetId next_text_id() noexcept;
+  // Pushes the bytes hashed with the current id, on failure the current id
+  // is reused until the matching pop_id
+  void push_id_bytes(const void* data, u64 length) noexcept;
+  // Points the per frame vectors at this arena, call after moves
+  void attach_arena() noexcept;
+  // Counts the widget as drawn or culled against the active clip
+  [[nodiscard]] bool is_visible(const rect<f32>& rectangle) noexcept;
+  // Clips drawing and culling, nullptr resets to the window
+  void set_clip(const rect<f32>* clip) noexcept;
+  // Intersects the active clip with the area
+  void clip_to(const rect<f32>& area) noexcept;
+  // Applies the wheel when hovered, returns the clamped offset of the id
+  [[nodiscard]] f64 scroll_area(
+      WidgetId id, const rect<f32>& area, f64 content, f32 step
+  ) noexcept;
+  void draw_scrollbar(const rect<f32>& area, f64 content, f64 offset) noexcept;
+  // Pushes the layout widget and pops its area, false if it was stacked
+  [[nodiscard]] bool start_layout(Widget widget, rect<f32>& area) noexcept;
+  // Growth failures skip widgets instead of aborting
+  static void warn_layout() noexcept;
+
+  // Lays out the columns and clips to the body, returns the visible rows
+  [[nodiscard]] ScrollRange start_table(
+      const c8* id, const i32* widths, i32 widths_size, i32 row_count,
+      i32 header_rows
+  ) noexcept;
+  // Clips to the whole table for the header rows
+  void start_table_header() noexcept;
+  void end_table() noexcept;
+  template <typename Cell> void table_row(i32 row, Cell& cell) noexcept;
+  [[nodiscard]] rect<f32>
+  get_table_cell_area(i32 row, i32 column) const noexcept;
+  [[nodiscard]] u64 get_table_cell_key(i32 row, i32 column) const noexcept;
+  // Caches the text cut to the cell width
+  [[nodiscard]] const TableCell& cache_table_cell(
+      u64 key, const rect<f32>& area, const c8* text
+  ) noexcept;
+  void draw_table_cell(const TableCell& cell, const rect<f32>& area) noexcept;
+
+  // Area of the plot and its pixel columns from the frame arena, nullptr if
+  // there is nothing to draw. Always takes the widget size
+  [[nodiscard]] PlotRange* start_plot(rect<f32>& area, i32 samples) noexcept;
+  void draw_plot(
+      const rect<f32>& area, const PlotRange* columns, rgba8 color,
+      PlotRange range
+  ) noexcept;
 };
 
+template <i32... Widths> void Window::start_row() noexcept {
+  rect<f32> rectangle{};
+  if (!this->start_layout(Widget::ROW, rectangle)) {
+    return;
+  }
+
+  if (layout::push_row<Widths...>(
+          this->state.widget_sizes, rectangle, this->state.alignments
+      ) != error_codes::OK) {
+    warn_layout();
+  }
+}
+
+template <i32... Heights> void Window::start_column() noexcept {
+  rect<f32> rectangle{};
+  if (!this->start_layout(Widget::COLUMN, rectangle)) {
+    return;
+  }
+
+  if (layout::push_column<Heights...>(
+          this->state.widget_sizes, rectangle, this->state.alignments
+      ) != error_codes::OK) {
+    warn_layout();
+  }
+}
+
+template <typename Cell>
+void Window::table(
+    const c8* id, const i32* widths, i32 widths_size, i32 row_count,
+    i32 header_rows, Cell&& cell
+) noexcept {
+  static_assert(
+      std::is_invocable_r_v<const c8*, Cell&, i32, i32>,
+      "Table cells are const c8* cell(i32 row, i32 column)"
+  );
+
+  const ScrollRange range =
+      this->start_table(id, widths, widths_size, row_count, header_rows);
+  for (i32 row = range.first; row < range.first + range.count; ++row) {
+    this->table_row(row, cell);
+  }
+
+  this->start_table_header();
+  for (i32 row = 0; row < this->state.table.header_rows; ++row) {
+    this->table_row(row, cell);
+  }
+  this->end_table();
+}
+
+template <typename Cell>
+void Window::table(
+    const c8* id, const ds::vector<i32>& widths, i32 row_count,
+    i32 header_rows, Cell&& cell
+) noexcept {
+  this->table(
+      id, widths.get_data(), widths.get_size(), row_count, header_rows, cell
+  );
+}
+
+template <typename Cell>
+void Window::table_row(i32 row, Cell& cell) noexcept {
+  for (i32 column = 0; column < this->state.table_columns.get_size();
+       ++column) {
+    const rect<f32> area = this->get_table_cell_area(row, column);
+    if (!this->is_visible(area)) {
+      continue;
+    }
+
+    const u64 key = this->get_table_cell_key(row, column);
+    const TableCell* cached = this->tables.find(key);
+    if (cached == nullptr) {
+      cached = &this->cache_table_cell(key, area, cell(row, column));
+    }
+    this->draw_table_cell(*cached, area);
+  }
+}
+
 } // namespace immpp
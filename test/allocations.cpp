@@ -0,0 +1,124 @@
+#include "ds/vector.hpp"
+#include "immpp/allocations.hpp"
+#include "immpp/frame_arena.hpp"
+#include "immpp/layout.hpp"
+#include "immpp/layout_cache.hpp"
+#include "immpp/malloc_interposer.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include "immpp/widget_state.hpp"
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+
+using namespace immpp;
+
+TEST_CASE("Allocation scopes", "[allocations]") {
+  const u64 allocating_frames = allocations::get_allocating_frames();
+
+  allocations::begin_frame();
+  {
+    const allocations::Untracked untracked{};
+    allocations::record(1024);
+  }
+  {
+    const allocations::Scope layout{allocations::Subsystem::LAYOUT};
+    allocations::record(64);
+    {
+      const allocations::Scope text{allocations::Subsystem::TEXT};
+      allocations::record(16);
+    }
+    allocations::record(32);
+  }
+  allocations::end_frame();
+
+  const auto& frame = allocations::get_frame();
+  const auto& layout = frame.subsystems[(i32)allocations::Subsystem::LAYOUT];
+  const auto& text = frame.subsystems[(i32)allocations::Subsystem::TEXT];
+  REQUIRE(layout.allocations == 2);
+  REQUIRE(layout.bytes == 96);
+  REQUIRE(text.allocations == 1);
+  REQUIRE(text.bytes == 16);
+  REQUIRE(frame.total.allocations == 3);
+  REQUIRE(frame.total.bytes == 112);
+  REQUIRE(allocations::get_allocating_frames() == allocating_frames + 1);
+
+  allocations::begin_frame();
+  allocations::end_frame();
+  REQUIRE(allocations::get_frame().total.allocations == 0);
+  REQUIRE(allocations::get_allocating_frames() == allocating_frames + 1);
+}
+
+// Counted by immpp/malloc_interposer.cpp. The tests do not link SDL, so only
+// the layout side of a frame is covered here; whole Window frames with text,
+// draw lists and fonts are guarded by immpp_bench --strict.
+#ifdef __GLIBC__
+namespace {
+
+struct Frame {
+  FrameArena arena{};
+  FrameVector<rect<f32>> sizes{&this->arena};
+  LayoutCache layouts{};
+  WidgetStore states{};
+  ds::vector<i32> specs{};
+
+  // Layout work of a window frame without the SDL side
+  void run() {
+    this->arena.reset();
+    this->sizes.clear();
+    static_cast<void>(
+        this->sizes.push({.x = 0.0F, .y = 0.0F, .w = 800.0F, .h = 600.0F})
+    );
+
+    const rect<f32> root = this->sizes.pop();
+    static_cast<void>(
+        layout::push_column<size::encode_fixed(32), size::encode_grow(1)>(
+            this->sizes, root, Alignment::VERTICAL_TOP
+        )
+    );
+    const rect<f32> body = this->sizes.pop();
+    static_cast<void>(this->layouts.push_row(
+        this->sizes, body, this->specs.get_data(), this->specs.get_size(),
+        Alignment::HORIZONTAL_LEFT
+    ));
+    for (i32 i = 0; i < 64; ++i) {
+      static_cast<void>(this->arena.format("Label %d", i));
+      this->states.get(i + 1).scroll += 1.0;
+    }
+    this->layouts.next_frame();
+    this->states.next_frame();
+  }
+};
+
+} // namespace
+
+TEST_CASE("Steady state frame does not allocate", "[allocations]") {
+  Frame frame{};
+  for (i32 i = 0; i < 256; ++i) {
+    REQUIRE(frame.specs.push(size::encode_fixed(16)) == error_codes::OK);
+  }
+
+  SECTION("Interposer counts") {
+    const u64 calls = malloc_interposer::get_calls();
+    allocations::begin_frame();
+    void* volatile memory = std::malloc(32);
+    allocations::end_frame();
+    std::free(memory);
+    REQUIRE(allocations::get_frame().total.allocations == 1);
+    REQUIRE(malloc_interposer::get_calls() == calls + 1);
+  }
+
+  SECTION("Layout frame") {
+    for (i32 i = 0; i < 3; ++i) {
+      frame.run();
+    }
+
+    for (i32 i = 0; i < 10; ++i) {
+      allocations::begin_frame();
+      frame.run();
+      allocations::end_frame();
+      REQUIRE(allocations::get_frame().total.allocations == 0);
+    }
+  }
+}
+#endif
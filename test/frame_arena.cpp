@@ -0,0 +1,137 @@
+#include "immpp/frame_arena.hpp"
+#include "immpp/types.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+
+using namespace immpp;
+
+TEST_CASE("Frame arena", "[frame_arena]") {
+  FrameArena arena{};
+  arena.set_capacity(1024);
+  arena.reset();
+
+  SECTION("Alignment") {
+    const void* byte = arena.allocate(1, 1);
+    const void* aligned = arena.allocate(8, 16);
+    REQUIRE(byte != nullptr);
+    REQUIRE((uintptr_t)aligned % 16 == 0);
+    REQUIRE(arena.get_stats().used == 24);
+  }
+
+  SECTION("Strings") {
+    const c8* copy = arena.copy_string("hello world", 5);
+    REQUIRE(std::strcmp(copy, "hello") == 0);
+
+    const c8* formatted = arena.format("%d fps, %s", 60, "idle");
+    REQUIRE(std::strcmp(formatted, "60 fps, idle") == 0);
+  }
+
+  SECTION("Overflow grows on reset") {
+    for (i32 i = 0; i < 3; ++i) {
+      REQUIRE(arena.allocate(512) != nullptr);
+    }
+    REQUIRE(arena.get_stats().overflows == 1);
+    REQUIRE(arena.get_stats().used == 1536);
+
+    arena.reset();
+    REQUIRE(arena.get_stats().capacity == 2048);
+    REQUIRE(arena.get_stats().grows == 1);
+    REQUIRE(arena.get_stats().last_used == 1536);
+    REQUIRE(arena.get_stats().high_water == 1536);
+
+    for (i32 i = 0; i < 3; ++i) {
+      REQUIRE(arena.allocate(512) != nullptr);
+    }
+    arena.reset();
+    REQUIRE(arena.get_stats().overflows == 1);
+    REQUIRE(arena.get_stats().grows == 1);
+  }
+
+  SECTION("Capacity applies on reset") {
+    arena.set_capacity(4096);
+    REQUIRE(arena.get_stats().capacity == 1024);
+    arena.reset();
+    REQUIRE(arena.get_stats().capacity == 4096);
+  }
+}
+
+TEST_CASE("Frame vector", "[frame_arena]") {
+  FrameArena arena{};
+  FrameVector<i32> values{&arena};
+
+  SECTION("Growth keeps values") {
+    for (i32 i = 0; i < 100; ++i) {
+      REQUIRE(values.push(i) == error_codes::OK);
+    }
+    REQUIRE(values.get_size() == 100);
+    for (i32 i = 0; i < 100; ++i) {
+      REQUIRE(values[i] == i);
+    }
+    REQUIRE(values.pop() == 99);
+    REQUIRE(values.back() == 98);
+  }
+
+  SECTION("Reset drops the buffer and keeps the capacity") {
+    for (i32 i = 0; i < 100; ++i) {
+      REQUIRE(values.push(i) == error_codes::OK);
+    }
+    const i32 capacity = values.get_capacity();
+
+    arena.reset();
+    values.clear();
+    REQUIRE(values.is_empty());
+    REQUIRE(values.push(7) == error_codes::OK);
+    REQUIRE(values.get_capacity() == capacity);
+    REQUIRE(values[0] == 7);
+    // One reservation of the previous capacity
+    REQUIRE(arena.get_stats().used == sizeof(i32) * capacity);
+  }
+
+  SECTION("Steady state frames stay in the arena") {
+    for (i32 frame = 0; frame < 4; ++frame) {
+      arena.reset();
+      values.clear();
+      for (i32 i = 0; i < 10'000; ++i) {
+        REQUIRE(values.push(i) == error_codes::OK);
+      }
+    }
+    const u64 overflows = arena.get_stats().overflows;
+
+    for (i32 frame = 0; frame < 4; ++frame) {
+      arena.reset();
+      values.clear();
+      for (i32 i = 0; i < 10'000; ++i) {
+        REQUIRE(values.push(i) == error_codes::OK);
+      }
+    }
+    REQUIRE(arena.get_stats().overflows == overflows);
+  }
+
+  SECTION("Heap without an arena") {
+    FrameVector<i32> heap{};
+    for (i32 i = 0; i < 100; ++i) {
+      REQUIRE(heap.push(i) == error_codes::OK);
+    }
+    heap.clear();
+    REQUIRE(heap.is_empty());
+    REQUIRE(heap.get_capacity() >= 100);
+  }
+}
+
+TEST_CASE("Frame arena benchmark", "[frame_arena][!benchmark]") {
+  FrameArena arena{};
+  FrameVector<rect<f32>> sizes{&arena};
+
+  BENCHMARK("push 1024 rectangles") {
+    arena.reset();
+    sizes.clear();
+    for (i32 i = 0; i < 1024; ++i) {
+      static_cast<void>(
+          sizes.push({.x = (f32)i, .y = 0.0F, .w = 1.0F, .h = 1.0F})
+      );
+    }
+    return sizes.get_size();
+  };
+}
@@ -0,0 +1,558 @@
+#include "ds/vector.hpp"
+#include "immpp/frame_arena.hpp"
+#include "immpp/layout.hpp"
+#include "immpp/layout_cache.hpp"
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <string>
+
+using namespace immpp;
+
+namespace {
+
+const rect<f32> AREA{.x = 10.0F, .y = 20.0F, .w = 300.0F, .h = 200.0F};
+
+// Realistic mix of fixed, grow and fit specs
+[[nodiscard]] ds::vector<i32> make_specs(i32 count) {
+  ds::vector<i32> specs{};
+  for (i32 i = 0; i < count; ++i) {
+    i32 spec = 0;
+    switch (i % 3) {
+    case 0:
+      spec = size::encode_fixed(16 + (i % 32));
+      break;
+    case 1:
+      spec = size::encode_grow(1 + (i % 3));
+      break;
+    default:
+      spec = size::encode_fit();
+      break;
+    }
+    REQUIRE(specs.push(spec) == error_codes::OK);
+  }
+  return specs;
+}
+
+void require_rect(const rect<f32>& actual, rect<f32> expected) {
+  REQUIRE(actual.x == expected.x);
+  REQUIRE(actual.y == expected.y);
+  REQUIRE(actual.w == expected.w);
+  REQUIRE(actual.h == expected.h);
+}
+
+} // namespace
+
+TEST_CASE("Row layout", "[layout]") {
+  FrameVector<rect<f32>> sizes{};
+
+  SECTION("Fixed and grow") {
+    const std::array<i32, 3> widths{
+      size::encode_fixed(32), size::encode_grow(1), size::encode_fixed(100)
+    };
+    REQUIRE(
+        layout::push_row(
+            sizes, AREA, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_LEFT
+        ) == error_codes::OK
+    );
+
+    // First child is at the back
+    REQUIRE(sizes.get_size() == 3);
+    require_rect(sizes.pop(), {10.0F, 20.0F, 32.0F, 200.0F});
+    require_rect(sizes.pop(), {42.0F, 20.0F, 168.0F, 200.0F});
+    require_rect(sizes.pop(), {210.0F, 20.0F, 100.0F, 200.0F});
+  }
+
+  SECTION("Grow parts") {
+    const std::array<i32, 2> widths{
+      size::encode_grow(1), size::encode_grow(2)
+    };
+    REQUIRE(
+        layout::push_row(
+            sizes, AREA, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_LEFT
+        ) == error_codes::OK
+    );
+
+    require_rect(sizes.pop(), {10.0F, 20.0F, 100.0F, 200.0F});
+    require_rect(sizes.pop(), {110.0F, 20.0F, 200.0F, 200.0F});
+  }
+
+  SECTION("Alignment without grow") {
+    const std::array<i32, 2> widths{
+      size::encode_fixed(50), size::encode_fixed(50)
+    };
+
+    REQUIRE(
+        layout::push_row(
+            sizes, AREA, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_LEFT
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().x == 10.0F);
+    REQUIRE(sizes.pop().x == 60.0F);
+
+    REQUIRE(
+        layout::push_row(
+            sizes, AREA, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_CENTER
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().x == 110.0F);
+    REQUIRE(sizes.pop().x == 160.0F);
+
+    REQUIRE(
+        layout::push_row(
+            sizes, AREA, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_RIGHT
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().x == 210.0F);
+    REQUIRE(sizes.pop().x == 260.0F);
+  }
+
+  SECTION("Overflowing fixed sizes") {
+    const std::array<i32, 2> widths{
+      size::encode_fixed(250), size::encode_grow(1)
+    };
+    REQUIRE(
+        layout::push_row(
+            sizes, {0.0F, 0.0F, 200.0F, 10.0F}, widths.data(), widths.size(),
+            Alignment::HORIZONTAL_LEFT
+        ) == error_codes::OK
+    );
+
+    REQUIRE(sizes.pop().w == 250.0F);
+    REQUIRE(sizes.pop().w == 0.0F);
+  }
+}
+
+TEST_CASE("Column layout", "[layout]") {
+  FrameVector<rect<f32>> sizes{};
+
+  SECTION("Fixed and grow") {
+    const std::array<i32, 2> heights{
+      size::encode_grow(1), size::encode_fixed(100)
+    };
+    REQUIRE(
+        layout::push_column(
+            sizes, AREA, heights.data(), heights.size(),
+            Alignment::VERTICAL_TOP
+        ) == error_codes::OK
+    );
+
+    require_rect(sizes.pop(), {10.0F, 20.0F, 300.0F, 100.0F});
+    require_rect(sizes.pop(), {10.0F, 120.0F, 300.0F, 100.0F});
+  }
+
+  SECTION("Alignment without grow") {
+    const std::array<i32, 1> heights{size::encode_fixed(100)};
+
+    REQUIRE(
+        layout::push_column(
+            sizes, AREA, heights.data(), heights.size(),
+            Alignment::VERTICAL_TOP
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().y == 20.0F);
+
+    REQUIRE(
+        layout::push_column(
+            sizes, AREA, heights.data(), heights.size(),
+            Alignment::VERTICAL_CENTER
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().y == 70.0F);
+
+    REQUIRE(
+        layout::push_column(
+            sizes, AREA, heights.data(), heights.size(),
+            Alignment::VERTICAL_BOTTOM
+        ) == error_codes::OK
+    );
+    REQUIRE(sizes.pop().y == 120.0F);
+  }
+}
+
+TEST_CASE("Normalize rectangle", "[layout]") {
+  const rect<f32> limits{.x = 0.0F, .y = 0.0F, .w = 100.0F, .h = 200.0F};
+
+  rect<f32> rectangle{10.7F, 20.2F, size::GROW_F32, 30.0F};
+  layout::normalize_rectangle(rectangle, limits);
+  require_rect(rectangle, {10.0F, 20.0F, 90.0F, 30.0F});
+
+  rectangle = {-5.0F, 50.0F, size::GROW_F32, size::FIT_F32};
+  layout::normalize_rectangle(rectangle, limits);
+  require_rect(rectangle, {-5.0F, 50.0F, 100.0F, 150.0F});
+}
+
+TEST_CASE("Rectangle overlap", "[layout]") {
+  const rect<f32> clip{.x = 0.0F, .y = 0.0F, .w = 100.0F, .h = 100.0F};
+
+  REQUIRE(clip.overlaps({50.0F, 50.0F, 10.0F, 10.0F}));
+  REQUIRE(clip.overlaps({-5.0F, 90.0F, 10.0F, 20.0F}));
+  REQUIRE(clip.overlaps({-50.0F, -50.0F, 200.0F, 200.0F}));
+  // Touching edges only
+  REQUIRE_FALSE(clip.overlaps({100.0F, 0.0F, 10.0F, 10.0F}));
+  REQUIRE_FALSE(clip.overlaps({0.0F, -16.0F, 10.0F, 16.0F}));
+  REQUIRE_FALSE(clip.overlaps({0.0F, 400.0F, 100.0F, 16.0F}));
+}
+
+TEST_CASE("Text rectangle", "[layout]") {
+  const vec2<f32> fit_size{20.0F, 10.0F};
+  const vec2<f32> max_size{400.0F, 300.0F};
+
+  SECTION("Centered in a fixed area") {
+    require_rect(
+        layout::calculate_text_rectangle(
+            {10.0F, 10.0F, 100.0F, 50.0F}, fit_size, max_size
+        ),
+        {50.0F, 30.0F, 20.0F, 10.0F}
+    );
+  }
+
+  SECTION("Fit area") {
+    require_rect(
+        layout::calculate_text_rectangle(
+            {10.0F, 10.0F, size::FIT_F32, size::FIT_F32}, fit_size, max_size
+        ),
+        {10.0F, 10.0F, 20.0F, 10.0F}
+    );
+  }
+
+  SECTION("Grow area uses the max size") {
+    require_rect(
+        layout::calculate_text_rectangle(
+            {0.0F, 0.0F, size::GROW_F32, size::GROW_F32}, fit_size, max_size
+        ),
+        {190.0F, 145.0F, 20.0F, 10.0F}
+    );
+  }
+
+  SECTION("Truncated position") {
+    const auto output = layout::calculate_text_rectangle(
+        {0.0F, 0.0F, 25.0F, 15.0F}, fit_size, max_size
+    );
+    REQUIRE(output.x == 2.0F);
+    REQUIRE(output.y == 2.0F);
+  }
+}
+
+TEST_CASE("Scroll range", "[layout]") {
+  SECTION("Clamped offset") {
+    REQUIRE(layout::clamp_scroll(-10.0, 1000.0, 200.0F) == 0.0);
+    REQUIRE(layout::clamp_scroll(500.0, 1000.0, 200.0F) == 500.0);
+    REQUIRE(layout::clamp_scroll(900.0, 1000.0, 200.0F) == 800.0);
+    // Content smaller than the viewport does not scroll
+    REQUIRE(layout::clamp_scroll(50.0, 100.0, 200.0F) == 0.0);
+  }
+
+  SECTION("Partially visible items") {
+    const ScrollRange range =
+        layout::calculate_scroll_range(30.0, 100.0F, 20.0F, 50);
+    REQUIRE(range.first == 1);
+    REQUIRE(range.count == 6);
+  }
+
+  SECTION("End of the list") {
+    const ScrollRange range =
+        layout::calculate_scroll_range(900.0, 200.0F, 20.0F, 50);
+    REQUIRE(range.first == 45);
+    REQUIRE(range.count == 5);
+  }
+
+  SECTION("Empty list") {
+    const ScrollRange range =
+        layout::calculate_scroll_range(0.0, 200.0F, 20.0F, 0);
+    REQUIRE(range.count == 0);
+  }
+
+  SECTION("Million items") {
+    const i32 count = 1'000'000;
+    const f64 content = (f64)count * 16.0;
+    const f64 offset = layout::clamp_scroll(1e12, content, 480.0F);
+    REQUIRE(offset == content - 480.0);
+
+    const ScrollRange range =
+        layout::calculate_scroll_range(offset, 480.0F, 16.0F, count);
+    REQUIRE(range.first == count - 30);
+    REQUIRE(range.count == 30);
+
+    // Single pixel steps stay exact this deep into the list
+    const ScrollRange shifted =
+        layout::calculate_scroll_range(offset - 1.0, 480.0F, 16.0F, count);
+    REQUIRE(shifted.first == count - 31);
+    REQUIRE(shifted.count == 31);
+  }
+}
+
+TEST_CASE("Layout benchmark", "[layout][!benchmark]") {
+  FrameVector<rect<f32>> sizes{};
+  REQUIRE(sizes.reserve(4096) == error_codes::OK);
+
+  for (const i32 count : {2, 16, 256, 4096}) {
+    const auto specs = make_specs(count);
+    const std::string suffix = " " + std::to_string(count) + " children";
+
+    BENCHMARK("push_row" + suffix) {
+      sizes.clear();
+      return layout::push_row(
+          sizes, AREA, specs.get_data(), specs.get_size(),
+          Alignment::HORIZONTAL_CENTER
+      );
+    };
+
+    BENCHMARK("push_column" + suffix) {
+      sizes.clear();
+      return layout::push_column(
+          sizes, AREA, specs.get_data(), specs.get_size(),
+          Alignment::VERTICAL_CENTER
+      );
+    };
+
+    sizes.clear();
+    static_cast<void>(layout::push_row(
+        sizes, AREA, specs.get_data(), specs.get_size(),
+        Alignment::HORIZONTAL_LEFT
+    ));
+    BENCHMARK("normalize_rectangle" + suffix) {
+      f32 total = 0.0F;
+      for (i32 i = 0; i < sizes.get_size(); ++i) {
+        rect<f32> rectangle = sizes[i];
+        layout::normalize_rectangle(rectangle, AREA);
+        total += rectangle.w;
+      }
+      return total;
+    };
+
+    BENCHMARK("calculate_text_rectangle" + suffix) {
+      f32 total = 0.0F;
+      for (i32 i = 0; i < sizes.get_size(); ++i) {
+        total += layout::calculate_text_rectangle(
+                     sizes[i], {40.0F, 16.0F}, AREA.size
+        )
+                     .x;
+      }
+      return total;
+    };
+  }
+}
+
+TEST_CASE("Layout cache", "[layout]") {
+  LayoutCache cache{};
+  FrameVector<rect<f32>> cached{};
+  FrameVector<rect<f32>> computed{};
+  const auto specs = make_specs(64);
+
+  for (i32 frame = 0; frame < 3; ++frame) {
+    cached.clear();
+    REQUIRE(
+        cache.push_row(
+            cached, AREA, specs.get_data(), specs.get_size(),
+            Alignment::HORIZONTAL_CENTER
+        ) == error_codes::OK
+    );
+    REQUIRE(
+        cache.push_column(
+            cached, AREA, specs.get_data(), specs.get_size(),
+            Alignment::VERTICAL_CENTER
+        ) == error_codes::OK
+    );
+  }
+
+  REQUIRE(
+      layout::push_row(
+          computed, AREA, specs.get_data(), specs.get_size(),
+          Alignment::HORIZONTAL_CENTER
+      ) == error_codes::OK
+  );
+  REQUIRE(
+      layout::push_column(
+          computed, AREA, specs.get_data(), specs.get_size(),
+          Alignment::VERTICAL_CENTER
+      ) == error_codes::OK
+  );
+
+  REQUIRE(cached.get_size() == computed.get_size());
+  for (i32 i = 0; i < computed.get_size(); ++i) {
+    require_rect(cached[i], computed[i]);
+  }
+
+  REQUIRE(cache.get_stats().misses == 2);
+  REQUIRE(cache.get_stats().hits == 4);
+  REQUIRE(cache.get_stats().count == 2);
+
+  SECTION("Different parent rectangle") {
+    cached.clear();
+    REQUIRE(
+        cache.push_row(
+            cached, {0.0F, 0.0F, 100.0F, 100.0F}, specs.get_data(),
+            specs.get_size(), Alignment::HORIZONTAL_CENTER
+        ) == error_codes::OK
+    );
+    REQUIRE(cache.get_stats().misses == 3);
+  }
+
+  SECTION("Clear") {
+    cache.clear();
+    REQUIRE(cache.get_stats().count == 0);
+
+    cached.clear();
+    REQUIRE(
+        cache.push_row(
+            cached, AREA, specs.get_data(), specs.get_size(),
+            Alignment::HORIZONTAL_CENTER
+        ) == error_codes::OK
+    );
+    REQUIRE(cache.get_stats().misses == 3);
+  }
+
+  SECTION("Scrolled areas are evicted in place") {
+    // A fixed header and rows moving by a pixel every frame
+    for (i32 frame = 0; frame < 200; ++frame) {
+      cached.clear();
+      REQUIRE(
+          cache.push_row(
+              cached, AREA, specs.get_data(), specs.get_size(),
+              Alignment::HORIZONTAL_CENTER
+          ) == error_codes::OK
+      );
+      for (i32 row = 0; row < 20; ++row) {
+        const rect<f32> area{
+          .x = 0.0F, .y = (f32)(frame + (row * 20)), .w = 400.0F, .h = 20.0F
+        };
+        REQUIRE(
+            cache.push_row(
+                cached, area, specs.get_data(), 8,
+                Alignment::HORIZONTAL_LEFT
+            ) == error_codes::OK
+        );
+      }
+      cache.next_frame();
+    }
+
+    REQUIRE(cache.get_stats().hits == 4 + 200);
+    REQUIRE(cache.get_stats().grows == 0);
+    REQUIRE(cache.get_stats().evictions > 0);
+    REQUIRE(cache.get_stats().rectangle_capacity <= 1024);
+  }
+}
+
+TEST_CASE("Layout cache benchmark", "[layout][!benchmark]") {
+  LayoutCache cache{};
+  FrameVector<rect<f32>> sizes{};
+  REQUIRE(sizes.reserve(4096) == error_codes::OK);
+
+  for (const i32 count : {2, 16, 256, 4096}) {
+    const auto specs = make_specs(count);
+    const std::string suffix = " " + std::to_string(count) + " children";
+
+    BENCHMARK("cached push_row" + suffix) {
+      sizes.clear();
+      return cache.push_row(
+          sizes, AREA, specs.get_data(), specs.get_size(),
+          Alignment::HORIZONTAL_CENTER
+      );
+    };
+  }
+}
+
+namespace {
+
+template <i32... Specs>
+void require_static_layouts(const rect<f32>& area, u8 alignments) {
+  const std::array<i32, sizeof...(Specs)> specs{Specs...};
+  FrameVector<rect<f32>> expected{};
+  FrameVector<rect<f32>> actual{};
+
+  REQUIRE(
+      layout::push_row(
+          expected, area, specs.data(), specs.size(), alignments
+      ) == error_codes::OK
+  );
+  REQUIRE(
+      layout::push_row<Specs...>(actual, area, alignments) == error_codes::OK
+  );
+  REQUIRE(
+      layout::push_column(
+          expected, area, specs.data(), specs.size(), alignments
+      ) == error_codes::OK
+  );
+  REQUIRE(
+      layout::push_column<Specs...>(actual, area, alignments) ==
+      error_codes::OK
+  );
+
+  // Offsets come from precomputed sums instead of a running subtraction,
+  // grow children can differ in the last bits
+  REQUIRE(actual.get_size() == expected.get_size());
+  for (i32 i = 0; i < expected.get_size(); ++i) {
+    REQUIRE(std::fabs(actual[i].x - expected[i].x) < 0.001F);
+    REQUIRE(std::fabs(actual[i].y - expected[i].y) < 0.001F);
+    REQUIRE(std::fabs(actual[i].w - expected[i].w) < 0.001F);
+    REQUIRE(std::fabs(actual[i].h - expected[i].h) < 0.001F);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Static layout", "[layout]") {
+  using Static = layout::StaticSpecs<
+      size::encode_fixed(32), size::encode_grow(1), size::encode_fixed(100),
+      size::encode_grow(2)>;
+  static_assert(Static::COUNT == 4);
+  static_assert(Static::FIXED == 132);
+  static_assert(Static::PARTS == 3);
+  static_assert(Static::GROW_SUFFIXES[0] == 3.0F);
+  static_assert(Static::FIXED_SUFFIXES[2] == 100.0F);
+
+  const std::array<u8, 3> alignments{
+    Alignment::HORIZONTAL_LEFT | Alignment::VERTICAL_TOP,
+    Alignment::HORIZONTAL_CENTER | Alignment::VERTICAL_CENTER,
+    Alignment::HORIZONTAL_RIGHT | Alignment::VERTICAL_BOTTOM,
+  };
+  for (const u8 alignment : alignments) {
+    require_static_layouts<
+        size::encode_fixed(32), size::encode_grow(1),
+        size::encode_fixed(100)>(AREA, alignment);
+    require_static_layouts<
+        size::encode_grow(1), size::encode_grow(2), size::encode_grow(3)>(
+        AREA, alignment
+    );
+    require_static_layouts<size::encode_fixed(16), size::encode_fixed(40)>(
+        AREA, alignment
+    );
+    // Overflowing fixed children
+    require_static_layouts<size::encode_fixed(250), size::encode_fixed(250)>(
+        AREA, alignment
+    );
+    require_static_layouts<>(AREA, alignment);
+  }
+}
+
+TEST_CASE("Static layout benchmark", "[layout][!benchmark]") {
+  FrameVector<rect<f32>> sizes{};
+  REQUIRE(sizes.reserve(64) == error_codes::OK);
+
+  const std::array<i32, 4> specs{
+    size::encode_fixed(32), size::encode_grow(1), size::encode_fixed(100),
+    size::encode_grow(2)
+  };
+  BENCHMARK("push_row 4 children") {
+    sizes.clear();
+    return layout::push_row(
+        sizes, AREA, specs.data(), specs.size(), Alignment::HORIZONTAL_LEFT
+    );
+  };
+
+  BENCHMARK("static push_row 4 children") {
+    sizes.clear();
+    return layout::push_row<
+        size::encode_fixed(32), size::encode_grow(1), size::encode_fixed(100),
+        size::encode_grow(2)>(sizes, AREA, Alignment::HORIZONTAL_LEFT);
+  };
+}
@@ -0,0 +1,172 @@
+#include "immpp/plot.hpp"
+#include "immpp/types.hpp"
+#include <algorithm>
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace immpp;
+
+namespace {
+
+[[nodiscard]] std::vector<f32> make_values(i32 count) {
+  std::vector<f32> values(count);
+  u32 state = 12345;
+  for (i32 i = 0; i < count; ++i) {
+    state = (state * 1'103'515'245U) + 12'345U;
+    values[i] = std::sin((f32)i * 0.01F) * 100.0F + (f32)(state >> 24);
+  }
+  return values;
+}
+
+[[nodiscard]] PlotRange scalar_min_max(const f32* values, i32 count) {
+  PlotRange output{values[0], values[0]};
+  for (i32 i = 1; i < count; ++i) {
+    output.min = std::min(output.min, values[i]);
+    output.max = std::max(output.max, values[i]);
+  }
+  return output;
+}
+
+void require_range(const PlotRange& output, const PlotRange& expected) {
+  REQUIRE(output.min == expected.min);
+  REQUIRE(output.max == expected.max);
+}
+
+} // namespace
+
+TEST_CASE("Plot min max", "[plot]") {
+  const std::vector<f32> values = make_values(1000);
+
+  SECTION("Every length and offset") {
+    for (i32 offset = 0; offset < 8; ++offset) {
+      for (i32 count = 1; count < 70; ++count) {
+        require_range(
+            plot::min_max(values.data() + offset, count),
+            scalar_min_max(values.data() + offset, count)
+        );
+      }
+    }
+  }
+
+  SECTION("Extremes in the tail") {
+    std::vector<f32> tail(19, 0.0F);
+    tail[18] = -5.0F;
+    tail[17] = 7.0F;
+    require_range(plot::min_max(tail.data(), 19), {-5.0F, 7.0F});
+  }
+}
+
+TEST_CASE("Plot decimation", "[plot]") {
+  const std::vector<f32> values = make_values(10'000);
+
+  SECTION("Columns cover all values") {
+    std::vector<PlotRange> columns(640);
+    plot::decimate(values.data(), 10'000, columns.data(), 640);
+
+    PlotRange total = columns[0];
+    for (const PlotRange& column : columns) {
+      total.min = std::min(total.min, column.min);
+      total.max = std::max(total.max, column.max);
+    }
+    require_range(total, scalar_min_max(values.data(), 10'000));
+    // 15 or 16 values per column
+    require_range(columns[1], scalar_min_max(values.data() + 15, 16));
+  }
+
+  SECTION("Less values than columns") {
+    const std::array<f32, 3> few{1.0F, 2.0F, 3.0F};
+    std::vector<PlotRange> columns(9);
+    plot::decimate(few.data(), 3, columns.data(), 9);
+    require_range(columns[0], {1.0F, 1.0F});
+    require_range(columns[4], {2.0F, 2.0F});
+    require_range(columns[8], {3.0F, 3.0F});
+  }
+}
+
+TEST_CASE("Plot series", "[plot]") {
+  PlotSeries series{};
+  REQUIRE(series.set_capacity(1000) == error_codes::OK);
+  REQUIRE(series.get_capacity() == 1024);
+
+  const std::vector<f32> values = make_values(5000);
+
+  SECTION("Single pushes wrap around") {
+    for (i32 i = 0; i < 3000; ++i) {
+      series.push(values[i]);
+    }
+    REQUIRE(series.get_size() == 1024);
+    REQUIRE(series[0] == values[3000 - 1024]);
+    REQUIRE(series[1023] == values[2999]);
+
+    const f32* window = values.data() + 3000 - 1024;
+    for (i32 first = 0; first < 1024; first += 37) {
+      for (i32 count = 1; first + count <= 1024; count += 61) {
+        require_range(
+            series.get_range(first, count),
+            scalar_min_max(window + first, count)
+        );
+      }
+    }
+  }
+
+  SECTION("Bulk pushes match single pushes") {
+    PlotSeries single{};
+    REQUIRE(single.set_capacity(1000) == error_codes::OK);
+    for (i32 i = 0; i < 2500; ++i) {
+      single.push(values[i]);
+    }
+    series.push(values.data(), 700);
+    series.push(values.data() + 700, 1);
+    series.push(values.data() + 701, 1799);
+
+    std::vector<PlotRange> expected(100);
+    std::vector<PlotRange> output(100);
+    single.decimate(0, 1024, expected.data(), 100);
+    series.decimate(0, 1024, output.data(), 100);
+    for (i32 i = 0; i < 100; ++i) {
+      require_range(output[i], expected[i]);
+    }
+  }
+
+  SECTION("Decimation matches the array") {
+    series.push(values.data(), 5000);
+    const f32* window = values.data() + 5000 - 1024;
+
+    std::vector<PlotRange> expected(300);
+    std::vector<PlotRange> output(300);
+    plot::decimate(window, 1024, expected.data(), 300);
+    series.decimate(0, 1024, output.data(), 300);
+    for (i32 i = 0; i < 300; ++i) {
+      require_range(output[i], expected[i]);
+    }
+  }
+}
+
+TEST_CASE("Plot benchmark", "[plot][!benchmark]") {
+  const i32 count = 1'000'000;
+  const std::vector<f32> values = make_values(count);
+  std::vector<PlotRange> columns(1920);
+
+  PlotSeries series{};
+  REQUIRE(series.set_capacity(count) == error_codes::OK);
+  series.push(values.data(), count);
+
+  BENCHMARK("decimate 1M values to 1920 columns") {
+    plot::decimate(values.data(), count, columns.data(), 1920);
+    return columns[0].min;
+  };
+
+  BENCHMARK("decimate 1M series to 1920 columns") {
+    series.decimate(0, series.get_size(), columns.data(), 1920);
+    return columns[0].min;
+  };
+
+  BENCHMARK("push 1000 values and decimate") {
+    series.push(values.data(), 1000);
+    series.decimate(0, series.get_size(), columns.data(), 1920);
+    return columns[0].min;
+  };
+}
@@ -0,0 +1,105 @@
+#include "immpp/size.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace immpp;
+
+TEST_CASE("Int sizes", "[size]") {
+  SECTION("Fixed") {
+    const i32 encoded = size::encode_fixed(32);
+    REQUIRE(size::decode_fixed(encoded) == 32);
+    REQUIRE_FALSE(size::is_grow(encoded));
+    REQUIRE_FALSE(size::is_fit(encoded));
+  }
+
+  SECTION("Grow") {
+    const i32 encoded = size::encode_grow(3);
+    REQUIRE(size::is_grow(encoded));
+    REQUIRE(size::decode_grow(encoded) == 3);
+    REQUIRE_FALSE(size::is_fit(encoded));
+  }
+
+  SECTION("Fit") {
+    const i32 encoded = size::encode_fit();
+    REQUIRE(size::is_fit(encoded));
+    REQUIRE_FALSE(size::is_grow(encoded));
+  }
+}
+
+TEST_CASE("Constexpr int sizes", "[size]") {
+  static_assert(size::decode_fixed(size::encode_fixed(32)) == 32);
+  static_assert(size::decode_grow(size::encode_grow(3)) == 3);
+  static_assert(size::is_grow(size::encode_grow(1)));
+  static_assert(!size::is_grow(size::encode_fixed(32)));
+  static_assert(size::is_fit(size::encode_fit()));
+  SUCCEED();
+}
+
+TEST_CASE("Float sizes", "[size]") {
+  REQUIRE(size::is_type(size::GROW_F32));
+  REQUIRE(size::is_grow(size::GROW_F32));
+  REQUIRE_FALSE(size::is_fit(size::GROW_F32));
+
+  REQUIRE(size::is_type(size::FIT_F32));
+  REQUIRE(size::is_fit(size::FIT_F32));
+  REQUIRE_FALSE(size::is_grow(size::FIT_F32));
+
+  REQUIRE_FALSE(size::is_type(32.0F));
+}
+
+TEST_CASE("Size helpers benchmark", "[size][!benchmark]") {
+  std::array<i32, 1024> specs{};
+  for (i32 i = 0; i < (i32)specs.size(); ++i) {
+    switch (i % 3) {
+    case 0:
+      specs[i] = size::encode_fixed(16 + (i % 32));
+      break;
+    case 1:
+      specs[i] = size::encode_grow(1 + (i % 3));
+      break;
+    default:
+      specs[i] = size::encode_fit();
+      break;
+    }
+  }
+
+  BENCHMARK("decode 1024 mixed specs") {
+    i32 total = 0;
+    for (const i32 spec : specs) {
+      if (size::is_grow(spec)) {
+        total += size::decode_grow(spec);
+      } else if (!size::is_fit(spec)) {
+        total += size::decode_fixed(spec);
+      }
+    }
+    return total;
+  };
+
+  BENCHMARK("encode 1024 specs") {
+    i32 total = 0;
+    for (i32 i = 0; i < 1024; ++i) {
+      total ^= (i & 1) ? size::encode_grow(i) : size::encode_fixed(i);
+    }
+    return total;
+  };
+
+  std::array<f32, 1024> float_sizes{};
+  for (i32 i = 0; i < (i32)float_sizes.size(); ++i) {
+    float_sizes[i] = (i % 3 == 0)   ? size::GROW_F32
+                     : (i % 3 == 1) ? size::FIT_F32
+                                    : (f32)i;
+  }
+
+  BENCHMARK("is_type/is_fit/is_grow 1024 floats") {
+    i32 total = 0;
+    for (const f32 float_size : float_sizes) {
+      if (size::is_type(float_size)) {
+        total += size::is_fit(float_size) ? 1 : 2;
+        total += size::is_grow(float_size) ? 4 : 8;
+      }
+    }
+    return total;
+  };
+}
@@ -0,0 +1,137 @@
+#include "immpp/slot_table.hpp"
+#include "immpp/types.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace immpp;
+
+namespace {
+
+struct Entry {
+  u64 key;
+  u32 generation;
+  u32 value;
+};
+
+i32 released = 0; // NOLINT
+
+void release(Entry& entry) noexcept {
+  released += (i32)entry.value;
+}
+
+} // namespace
+
+TEST_CASE("Slot table", "[slot_table]") {
+  SlotTable<Entry> table{64};
+
+  SECTION("Insert and find") {
+    REQUIRE(table.find(42) == nullptr);
+
+    bool is_new = false;
+    table.insert(42, &is_new)->value = 7;
+    REQUIRE(is_new);
+    REQUIRE(table.insert(42, &is_new)->value == 7);
+    REQUIRE_FALSE(is_new);
+    REQUIRE(table.find(42)->value == 7);
+    REQUIRE(table.get_count() == 1);
+  }
+
+  SECTION("Old entries are evicted in place") {
+    for (u64 key = 1; key <= 40; ++key) {
+      table.insert(key)->value = (u32)key;
+    }
+    table.next_frame();
+    table.next_frame();
+
+    // Still in use, survives the eviction
+    REQUIRE(table.find(1) != nullptr);
+    for (u64 key = 100; key < 120; ++key) {
+      static_cast<void>(table.insert(key));
+    }
+    REQUIRE(table.get_evictions() == 39);
+    REQUIRE(table.get_grows() == 0);
+    REQUIRE(table.get_capacity() == 64);
+    REQUIRE(table.find(1)->value == 1);
+    REQUIRE(table.find(2) == nullptr);
+    REQUIRE(table.find(119) != nullptr);
+  }
+
+  SECTION("Grows to fit a larger working set") {
+    // Same keys every frame, more than fit at the starting capacity
+    for (i32 frame = 0; frame < 10; ++frame) {
+      for (u64 key = 1; key <= 200; ++key) {
+        static_cast<void>(table.insert(key * 0x9e37'79b9'7f4a'7c15));
+      }
+      table.next_frame();
+    }
+    REQUIRE(table.get_count() == 200);
+    REQUIRE(table.get_capacity() == 512);
+    REQUIRE(table.get_grows() == 3);
+    REQUIRE(table.get_evictions() == 0);
+  }
+
+  SECTION("Scrolling keys are evicted without growing") {
+    // 20 new keys per frame, like the rows scrolled into a table
+    for (u64 frame = 0; frame < 100; ++frame) {
+      for (u64 key = 1; key <= 20; ++key) {
+        static_cast<void>(table.insert((frame * 20) + key));
+      }
+      table.next_frame();
+    }
+    REQUIRE(table.get_grows() == 0);
+    REQUIRE(table.get_capacity() == 64);
+    REQUIRE(table.find((99 * 20) + 1) != nullptr);
+  }
+
+  SECTION("Removal keeps colliding keys reachable") {
+    const u64 capacity = table.get_capacity();
+    // Same home slot, one probe chain wrapping around the end
+    for (u64 i = 0; i < 4; ++i) {
+      table.insert(capacity - 1 + (i * capacity))->value = (u32)i + 1;
+    }
+    table.next_frame();
+    table.next_frame();
+    static_cast<void>(table.find(capacity - 1 + capacity));
+    static_cast<void>(table.find(capacity - 1 + (3 * capacity)));
+
+    REQUIRE(table.evict() == 2);
+    REQUIRE(table.get_count() == 2);
+    REQUIRE(table.find(capacity - 1 + capacity)->value == 2);
+    REQUIRE(table.find(capacity - 1 + (3 * capacity))->value == 4);
+  }
+
+  SECTION("Sweep spreads the eviction") {
+    table.set_max_age(2);
+    for (u64 key = 1; key <= 10; ++key) {
+      static_cast<void>(table.insert(key));
+    }
+    for (i32 frame = 0; frame < 8; ++frame) {
+      static_cast<void>(table.find(5));
+      table.next_frame();
+      table.sweep(16);
+    }
+    REQUIRE(table.get_count() == 1);
+    REQUIRE(table.find(5) != nullptr);
+  }
+
+  SECTION("Removed entries are released") {
+    released = 0;
+    {
+      SlotTable<Entry> owning{64, 1, release};
+      for (u64 key = 1; key <= 4; ++key) {
+        owning.insert(key)->value = 1;
+      }
+      owning.next_frame();
+      owning.next_frame();
+      static_cast<void>(owning.find(4));
+      REQUIRE(owning.evict() == 3);
+      REQUIRE(released == 3);
+
+      owning.insert(5)->value = 10;
+      owning.clear();
+      REQUIRE(released == 14);
+
+      owning.insert(6)->value = 100;
+    }
+    REQUIRE(released == 114);
+  }
+}
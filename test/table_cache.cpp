@@ -0,0 +1,93 @@
+#include "immpp/table_cache.hpp"
+#include "immpp/types.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <string>
+
+using namespace immpp;
+
+TEST_CASE("Table cache", "[table_cache]") {
+  TableCache cache{};
+  cache.set_capacity(64);
+
+  SECTION("Insert and find") {
+    REQUIRE(cache.find(42) == nullptr);
+
+    TableCell& cell = cache.insert(42, "row 1");
+    cell.size = {30, 16};
+    REQUIRE(cell.length == 5);
+
+    const TableCell* found = cache.find(42);
+    REQUIRE(found != nullptr);
+    REQUIRE(std::strcmp(cache.get_text(*found), "row 1") == 0);
+    REQUIRE(found->size.x == 30);
+    REQUIRE(cache.get_stats().hits == 1);
+    REQUIRE(cache.get_stats().misses == 1);
+    REQUIRE(cache.get_stats().count == 1);
+  }
+
+  SECTION("Reinsert replaces the text") {
+    static_cast<void>(cache.insert(7, "old"));
+    static_cast<void>(cache.insert(7, "new text"));
+    REQUIRE(cache.get_stats().count == 1);
+    REQUIRE(cache.find(7)->length == 8);
+  }
+
+  SECTION("Long text is kept") {
+    const std::string text(200, 'x');
+    const TableCell& cell = cache.insert(1, text.c_str());
+    REQUIRE(cell.length == 200);
+    REQUIRE(cache.get_text(cell) == text);
+
+    static_cast<void>(cache.insert(2, text.c_str(), 150));
+    REQUIRE(cache.get_text(*cache.find(1)) == text);
+    REQUIRE(cache.get_text(*cache.find(2)) == text.substr(0, 150));
+  }
+
+  SECTION("Text is cut between UTF-8 sequences") {
+    // 'a' and then the 2 bytes of U+00E9
+    const TableCell& cell = cache.insert(1, "a\xc3\xa9", 2);
+    REQUIRE(cell.length == 1);
+    REQUIRE(std::strcmp(cache.get_text(cell), "a") == 0);
+  }
+
+  SECTION("Long text of scrolled cells is reclaimed") {
+    const std::string text(300, 'y');
+    // 20 long cells per frame, like rows scrolled into a wide column
+    for (u64 frame = 0; frame < 200; ++frame) {
+      for (u64 row = 1; row <= 20; ++row) {
+        static_cast<void>(cache.insert((frame * 20) + row, text.c_str()));
+      }
+      cache.next_frame();
+    }
+    const i32 text_capacity = cache.get_stats().text_capacity;
+    REQUIRE(text_capacity <= 16 * 1024);
+    REQUIRE(cache.get_stats().grows == 0);
+    REQUIRE(cache.get_text(*cache.find((199 * 20) + 1)) == text);
+  }
+
+  SECTION("Unused cells are evicted first") {
+    for (u64 key = 1; key <= 40; ++key) {
+      static_cast<void>(cache.insert(key, "old"));
+    }
+    cache.next_frame();
+    cache.next_frame();
+
+    // Still in use, survives the eviction
+    REQUIRE(cache.find(1) != nullptr);
+    for (u64 key = 100; key < 120; ++key) {
+      static_cast<void>(cache.insert(key, "new"));
+    }
+    REQUIRE(cache.get_stats().evictions > 0);
+    REQUIRE(cache.find(1) != nullptr);
+    REQUIRE(cache.find(2) == nullptr);
+    REQUIRE(cache.find(119) != nullptr);
+  }
+
+  SECTION("Clear") {
+    static_cast<void>(cache.insert(3, "cell"));
+    cache.clear();
+    REQUIRE(cache.find(3) == nullptr);
+    REQUIRE(cache.get_stats().count == 0);
+  }
+}
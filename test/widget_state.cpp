@@ -0,0 +1,119 @@
+#include "immpp/types.hpp"
+#include "immpp/widget_state.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace immpp;
+
+TEST_CASE("Widget store", "[widget_state]") {
+  WidgetStore store{};
+
+  SECTION("States persist per id") {
+    WidgetState& state = store.get(42);
+    REQUIRE(state.scroll == 0.0);
+    state.scroll = 128.0;
+    state.values[0] = 0.5F;
+
+    store.next_frame();
+    REQUIRE(store.get(42).scroll == 128.0);
+    REQUIRE(store.get(42).values[0] == 0.5F);
+    REQUIRE(store.get(43).scroll == 0.0);
+    REQUIRE(store.get_stats().count == 2);
+    REQUIRE(store.find(44) == nullptr);
+  }
+
+  SECTION("Unused states are collected") {
+    store.set_max_age(2);
+    for (WidgetId id = 1; id <= 10; ++id) {
+      store.get(id).version = (u32)id;
+    }
+
+    // Enough frames to sweep every slot
+    const i32 frames =
+        WidgetStore::DEFAULT_CAPACITY / WidgetStore::SWEEP_SLOTS + 4;
+    for (i32 i = 0; i < frames; ++i) {
+      store.get(5).flags = 1;
+      store.next_frame();
+    }
+    REQUIRE(store.get_stats().count == 1);
+    REQUIRE(store.get_stats().collected == 9);
+    REQUIRE(store.find(5) != nullptr);
+    REQUIRE(store.find(5)->version == 5);
+    REQUIRE(store.find(6) == nullptr);
+  }
+
+  SECTION("A collected id comes back zeroed") {
+    store.set_max_age(1);
+    WidgetState& state = store.get(7);
+    state.scroll = 64.0;
+    state.values[3] = 1.0F;
+
+    const i32 frames =
+        WidgetStore::DEFAULT_CAPACITY / WidgetStore::SWEEP_SLOTS + 4;
+    for (i32 i = 0; i < frames; ++i) {
+      store.next_frame();
+    }
+    REQUIRE(store.find(7) == nullptr);
+
+    const WidgetState& reused = store.get(7);
+    REQUIRE(reused.scroll == 0.0);
+    REQUIRE(reused.values[3] == 0.0F);
+    REQUIRE(store.get_stats().created == 2);
+  }
+
+  SECTION("Clear drops the states and keeps the capacity") {
+    for (WidgetId id = 1; id <= 300; ++id) {
+      store.get(id).flags = 1;
+    }
+    const i32 capacity = store.get_stats().capacity;
+    store.clear();
+
+    REQUIRE(store.get_stats().count == 0);
+    REQUIRE(store.get_stats().capacity == capacity);
+    REQUIRE(store.find(1) == nullptr);
+    REQUIRE(store.get(1).flags == 0);
+  }
+
+  SECTION("Growth keeps the states") {
+    for (WidgetId id = 1; id <= 1000; ++id) {
+      store.get(id).version = (u32)id;
+    }
+    REQUIRE(store.get_stats().grows > 0);
+    REQUIRE(store.get_stats().count == 1000);
+    for (WidgetId id = 1; id <= 1000; ++id) {
+      REQUIRE(store.find(id)->version == id);
+    }
+  }
+
+  SECTION("Collection before growth") {
+    store.set_max_age(1);
+    for (WidgetId id = 1; id <= 150; ++id) {
+      static_cast<void>(store.get(id));
+    }
+    store.next_frame();
+    store.next_frame();
+    store.next_frame();
+    for (WidgetId id = 1000; id < 1150; ++id) {
+      static_cast<void>(store.get(id));
+    }
+    REQUIRE(store.get_stats().grows == 0);
+    const i32 capacity = WidgetStore::DEFAULT_CAPACITY;
+    REQUIRE(store.get_stats().capacity == capacity);
+  }
+}
+
+TEST_CASE("Widget store benchmark", "[widget_state][!benchmark]") {
+  WidgetStore store{};
+  for (WidgetId id = 1; id <= 1000; ++id) {
+    static_cast<void>(store.get(id * 0x9e37'79b9'7f4a'7c15));
+  }
+
+  BENCHMARK("get 1000 states") {
+    f64 total = 0.0;
+    for (WidgetId id = 1; id <= 1000; ++id) {
+      total += store.get(id * 0x9e37'79b9'7f4a'7c15).scroll;
+    }
+    store.next_frame();
+    return total;
+  };
+}
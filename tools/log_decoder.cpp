@@ -0,0 +1,258 @@
+#include "immpp/binary_log.hpp"
+#include "immpp/types.hpp"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace immpp;
+using namespace immpp::binary_log;
+
+namespace {
+
+struct Format {
+  const c8* text = nullptr;
+  u8 level = 0;
+};
+
+// Indexed by LogLevel
+const std::array<const c8*, 6> LEVEL_LABELS{
+  "", "fatal", "error", "warn", "info", "debug"
+};
+
+[[nodiscard]] u8* read_file(const c8* path, u64& size) noexcept {
+  FILE* file = std::fopen(path, "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+
+  std::fseek(file, 0, SEEK_END);
+  const long length = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  if (length <= 0) {
+    std::fclose(file);
+    return nullptr;
+  }
+
+  auto* data = (u8*)std::malloc(length);
+  if (data == nullptr ||
+      std::fread(data, 1, length, file) != static_cast<u64>(length)) {
+    std::free(data);
+    std::fclose(file);
+    return nullptr;
+  }
+
+  std::fclose(file);
+  size = length;
+  return data;
+}
+
+void print_timestamp(const FileHeader& header, u64 time) noexcept {
+  const i64 delta = static_cast<i64>(time - header.steady_time);
+  const u64 wall_time = header.wall_time + delta;
+  const time_t seconds = static_cast<time_t>(wall_time / 1'000'000'000);
+
+  std::array<c8, 32> date{};
+  static_cast<void>(std::strftime(
+      date.data(), date.size(), "%Y-%m-%dT%H:%M:%S",
+      std::localtime(&seconds) // NOLINT
+  ));
+  std::printf(
+      "%s.%06llu ", date.data(),
+      static_cast<unsigned long long>((wall_time % 1'000'000'000) / 1'000)
+  );
+}
+
+// Replays the printf conversions of format over the recorded arguments
+void print_message(const c8* format, const u8* cursor, const u8* end) noexcept {
+  std::array<c8, MAX_STRING + 1> string{};
+
+  while (*format != '\0') {
+    if (*format != '%') {
+      std::putchar(*format++);
+      continue;
+    }
+    if (format[1] == '%') {
+      std::putchar('%');
+      format += 2;
+      continue;
+    }
+
+    // Flags, width and precision, the length modifiers are replaced
+    std::array<c8, 32> spec{};
+    u64 spec_length = 0;
+    spec[spec_length++] = *format++;
+    while (*format != '\0' && std::strchr("-+ #0123456789.", *format) &&
+           spec_length < spec.size() - 4) {
+      spec[spec_length++] = *format++;
+    }
+    while (*format != '\0' && std::strchr("hlLqjzt", *format)) {
+      ++format;
+    }
+
+    const c8 conversion = *format;
+    if (conversion == '\0') {
+      break;
+    }
+    ++format;
+
+    if (cursor >= end) {
+      std::printf("<missing>");
+      continue;
+    }
+
+    // Every read is checked against the record, the file may be corrupt
+    const auto kind = static_cast<ArgumentKind>(*cursor++);
+    if (kind == ArgumentKind::STRING) {
+      u16 length = 0;
+      if (end - cursor < (i64)sizeof length) {
+        std::printf("<truncated>");
+        break;
+      }
+      std::memcpy(&length, cursor, sizeof length);
+      cursor += sizeof length;
+      if (length > MAX_STRING || end - cursor < length) {
+        std::printf("<truncated>");
+        break;
+      }
+      std::memcpy(string.data(), cursor, length);
+      string[length] = '\0';
+      cursor += length;
+
+      if (conversion != 's') {
+        std::printf("<bad conversion>");
+        continue;
+      }
+      spec[spec_length] = 's';
+      std::printf(spec.data(), string.data()); // NOLINT
+      continue;
+    }
+
+    if (kind != ArgumentKind::SIGNED && kind != ArgumentKind::UNSIGNED &&
+        kind != ArgumentKind::FLOAT && kind != ArgumentKind::POINTER) {
+      // Unknown size, the following arguments can not be found
+      std::printf("<bad conversion>");
+      break;
+    }
+    u64 raw = 0;
+    if (end - cursor < (i64)sizeof raw) {
+      std::printf("<truncated>");
+      break;
+    }
+    std::memcpy(&raw, cursor, sizeof raw);
+    cursor += sizeof raw;
+
+    f64 floating = 0.0;
+    std::memcpy(&floating, &raw, sizeof floating);
+    const bool is_integer =
+        kind == ArgumentKind::SIGNED || kind == ArgumentKind::UNSIGNED;
+
+    // Only conversions matching the recorded kind reach printf
+    if (kind == ArgumentKind::FLOAT && std::strchr("fFeEgGaA", conversion)) {
+      spec[spec_length] = conversion;
+      std::printf(spec.data(), floating); // NOLINT
+    } else if (kind == ArgumentKind::POINTER && conversion == 'p') {
+      spec[spec_length] = 'p';
+      std::printf(spec.data(), (void*)raw); // NOLINT
+    } else if (is_integer && conversion == 'c') {
+      spec[spec_length] = 'c';
+      std::printf(spec.data(), static_cast<i32>(raw)); // NOLINT
+    } else if (is_integer && std::strchr("diouxX", conversion)) {
+      spec[spec_length] = 'l';
+      spec[spec_length + 1] = 'l';
+      spec[spec_length + 2] = conversion;
+      std::printf(spec.data(), static_cast<long long>(raw)); // NOLINT
+    } else {
+      std::printf("<bad conversion>");
+    }
+  }
+
+  std::putchar('\n');
+}
+
+} // namespace
+
+/**
+ * Usage: immpp_log_decoder log.bin
+ **/
+i32 main(i32 argc, c8** argv) noexcept {
+  if (argc < 2) {
+    std::fprintf(stderr, "Usage: %s log.bin\n", argv[0]);
+    return -1;
+  }
+
+  u64 size = 0;
+  u8* data = read_file(argv[1], size);
+  if (data == nullptr) {
+    std::fprintf(stderr, "Could not read '%s'\n", argv[1]);
+    return -1;
+  }
+
+  FileHeader header{};
+  if (size < sizeof header) {
+    std::fprintf(stderr, "'%s' is not an immpp log\n", argv[1]);
+    std::free(data);
+    return -1;
+  }
+  std::memcpy(&header, data, sizeof header);
+  if (std::memcmp(header.magic, "IMMPPLOG", sizeof header.magic) != 0 ||
+      header.version != VERSION) {
+    std::fprintf(stderr, "'%s' is not an immpp log\n", argv[1]);
+    std::free(data);
+    return -1;
+  }
+
+  // Formats can be written after the first message using them
+  std::array<Format, MAX_FORMATS> formats{};
+  for (i32 pass = 0; pass < 2; ++pass) {
+    u64 offset = header.header_size;
+    u64 messages = 0;
+
+    while (offset + sizeof(RecordHeader) <= size) {
+      RecordHeader record{};
+      std::memcpy(&record, data + offset, sizeof record);
+      if (record.kind == RecordKind::END || record.size < sizeof record ||
+          offset + record.size > size) {
+        break;
+      }
+
+      const u8* payload = data + offset + sizeof record;
+      // Formats without a terminator in their record are left unknown
+      if (pass == 0 && record.kind == RecordKind::FORMAT &&
+          record.format < MAX_FORMATS &&
+          std::memchr(payload, '\0', record.size - sizeof record) != nullptr) {
+        formats[record.format] = Format{(const c8*)payload, record.level};
+      }
+
+      if (pass == 1 && record.kind == RecordKind::MESSAGE) {
+        const u8 level = record.level < LEVEL_LABELS.size() ? record.level : 0;
+        print_timestamp(header, record.time);
+        std::printf("%s: ", LEVEL_LABELS[level]);
+
+        const c8* format = record.format < MAX_FORMATS
+                               ? formats[record.format].text
+                               : nullptr;
+        if (format == nullptr) {
+          std::printf("<unknown format %u>\n", record.format);
+        } else {
+          print_message(format, payload, data + offset + record.size);
+        }
+        ++messages;
+      }
+
+      offset += record.size;
+    }
+
+    if (pass == 1) {
+      std::fprintf(
+          stderr, "%llu messages, %llu dropped\n",
+          static_cast<unsigned long long>(messages),
+          static_cast<unsigned long long>(header.dropped)
+      );
+    }
+  }
+
+  std::free(data);
+  return 0;
+}